@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "display.h"
+#include "mock_bus.h"
+
+// Benchmark de taxa de quadros por backend: o mesmo quadro é enviado repetidamente
+// pelo barramento simulado, que acumula o tempo de fio no baudrate configurado.
+#define QUADROS 2000
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    static uint8_t ssd[ssd1306_buffer_length];
+    struct render_area frame_area = {
+        .start_column = 0,
+        .end_column = ssd1306_width - 1,
+        .start_page = 0,
+        .end_page = ssd1306_n_pages - 1
+    };
+    calculate_render_area_buffer_length(&frame_area);
+
+    ssd1306_init();
+    ssd1306_draw_string(ssd, 5, 0, "MONITORAMENTO");
+    ssd1306_draw_string(ssd, 5, 8, "BPM 65 Med 65");
+    ssd1306_draw_line(ssd, 0, 63, ssd1306_width - 1, 32, true);
+
+    mock_bus_reset();
+    ssd1306_bytes_enviados = 0;
+    double inicio = agora_ns();
+    for (int i = 0; i < QUADROS; i++) {
+        render_on_display(ssd, &frame_area);
+    }
+    double cpu_ns = (agora_ns() - inicio) / QUADROS;
+    double barramento_ns = mock_bus_time_ns() / QUADROS;
+
+    printf("%-12s bytes/quadro=%-5u transacoes/quadro=%-3u barramento=%7.3f ms/quadro ",
+           DISPLAY_BACKEND_NAME, ssd1306_bytes_enviados / QUADROS,
+           mock_bus.transactions / QUADROS, barramento_ns / 1e6);
+    if (barramento_ns > 0) {
+        printf("fps_max=%6.1f ", 1e9 / barramento_ns);
+    }
+    printf("cpu_host=%.0f ns/quadro\n", cpu_ns);
+
+#if defined(DISPLAY_BACKEND_PBM)
+    if (argc > 1 && !display_pbm_save(argv[1])) {
+        fprintf(stderr, "Falha ao gravar %s\n", argv[1]);
+        return 1;
+    }
+#else
+    (void)argc; (void)argv;
+#endif
+    return 0;
+}
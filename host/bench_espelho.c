@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "display.h"
+#include "grafico_bpm.h"
+#include "espelho.h"
+#include "mock_bus.h"
+#include "tusb.h"
+
+// Capacidade do FIFO de transmissão do CDC no stdio_usb do SDK
+#define FIFO_CDC_BYTES 256
+
+// Benchmark do espelhamento do display (inc/espelho.c). Reproduz as telas do firmware
+// (mensagem inicial página a página, menu, monitoramento com texto a cada 250 ms e
+// gráfico a cada amostra, tela de alerta redesenhada a cada 50 ms) com o gancho de
+// render_on_display() ativo e o fluxo gravado em arquivo. Mede bytes por pacote
+// espelhado contra bytes no I2C, o custo de codificar contra o tempo de barramento e
+// confere o fluxo com o leitor usado por host/espelho_viewer.c. No meio do
+// monitoramento o host para de ler por 30 s (FIFO do CDC cheio com um pacote pela
+// metade): o firmware pula as áreas e o fluxo deve se ressincronizar sem falhas.
+//   bench_espelho [fluxo.bin]
+
+static uint8_t ssd[ssd1306_buffer_length];
+static const char *caminho = "espelho.bin";
+static bool ressincronizou = false;
+static struct render_area frame_area, text_area, pagina_area;
+static grafico_bpm_t grafico;
+
+// Mesmo roteiro de process_command() em tarefa-final.c: apaga, envia, escreve e envia
+static void tela(const char *l1, const char *l2, const char *l3, const char *l4) {
+    memset(ssd, 0, ssd1306_buffer_length);
+    render_on_display(ssd, &frame_area);
+    ssd1306_draw_string(ssd, 5, 0, (char *)l1);
+    ssd1306_draw_string(ssd, 5, 8, (char *)l2);
+    ssd1306_draw_string(ssd, 5, 16, (char *)l3);
+    ssd1306_draw_string(ssd, 5, 24, (char *)l4);
+    render_on_display(ssd, &frame_area);
+}
+
+static void texto_monitoramento(uint8_t bpm, uint8_t media) {
+    char linha[32];
+    snprintf(linha, sizeof(linha), "BPM %u Med %u ", bpm, media);
+    memset(ssd, 0, GRAFICO_BPM_PAGINA_INICIAL * ssd1306_width);
+    ssd1306_draw_string(ssd, 5, 0, "MONITORAMENTO");
+    ssd1306_draw_string(ssd, 5, 8, linha);
+    ssd1306_draw_string(ssd, 5, 16, "Giro Normal");
+    ssd1306_draw_string(ssd, 5, 24, "A VFC B Voltar");
+    render_on_display(ssd, &text_area);
+}
+
+// Lê o fluxo gravado até agora: o quadro reconstruído deve ser o desenhado, sem falhas
+static bool conferir_fluxo(espelho_leitor_t *leitor) {
+    fflush(mock_stdio_raw);
+    espelho_leitor_init(leitor);
+    FILE *f = fopen(caminho, "rb");
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        espelho_leitor_byte(leitor, c);
+    }
+    fclose(f);
+    return memcmp(leitor->quadro, ssd, ssd1306_buffer_length) == 0 && leitor->falhas == 0 && leitor->lacunas == 0;
+}
+
+static void roteiro(void) {
+    // Mensagem inicial, uma página por volta do laço
+    memset(ssd, 0, ssd1306_buffer_length);
+    ssd1306_draw_string(ssd, 5, 0, "Inicializando...");
+    ssd1306_draw_string(ssd, 5, 8, "Sistema de");
+    ssd1306_draw_string(ssd, 5, 16, "Monitoramento");
+    ssd1306_draw_string(ssd, 5, 24, "de Saude");
+    for (int pagina = 0; pagina < ssd1306_n_pages; pagina++) {
+        pagina_area.start_page = pagina_area.end_page = pagina;
+        render_on_display(ssd + pagina * ssd1306_width, &pagina_area);
+    }
+
+    // Menu com o cursor descendo e subindo
+    const char *itens[3][3] = {
+        {"l 1. Monitorar", "   2. Alarmes", "   3. Lembretes"},
+        {"   1. Monitorar", "l 2. Alarmes", "   3. Lembretes"},
+        {"   1. Monitorar", "   2. Alarmes", "l 3. Lembretes"},
+    };
+    for (int i = 0; i < 6; i++) {
+        const char **menu = itens[i < 3 ? i : 5 - i];
+        tela("MENU PRINCIPAL", menu[0], menu[1], menu[2]);
+    }
+
+    // Monitoramento por 5 minutos (passo de 50 ms): texto a cada 250 ms, amostra a cada 500 ms
+    tela("MONITORAMENTO", "", "", "");
+    grafico_bpm_redesenhar(&grafico, ssd);
+    uint8_t media = 65;
+    for (uint32_t t = 0; t < 300000; t += 50) {
+        // Host parado entre 120 s e 150 s; fora disso lê tudo entre as voltas do laço
+        mock_cdc_livre = (t == 120000) ? FIFO_CDC_BYTES / 2 : (t > 120000 && t < 150000) ? 0 : UINT32_MAX;
+        uint8_t bpm = 60 + (t / 7000) % 25;
+        if (t % 500 == 0) {
+            media = (media * 3 + bpm) / 4;
+            grafico_bpm_adicionar(&grafico, media);
+            grafico_bpm_atualizar(&grafico, ssd);
+            // A primeira área após a volta do host (só o gráfico) já traz o texto
+            // alterado durante a parada: deve sair como quadro-chave
+            if (t == 150000) {
+                espelho_leitor_t leitor;
+                ressincronizou = conferir_fluxo(&leitor);
+            }
+        }
+        if (t % 250 == 0) {
+            texto_monitoramento(bpm, media);
+        }
+    }
+
+    // Tela de alerta redesenhada a cada volta (50 ms) por 10 s
+    for (int i = 0; i < 200; i++) {
+        tela("ALERTA", "BATIMENTO ALTO", "BPM 125", "Pressione A");
+    }
+
+    tela("MENU PRINCIPAL", itens[0][0], itens[0][1], itens[0][2]);
+}
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    caminho = argc > 1 ? argv[1] : "espelho.bin";
+    frame_area = (struct render_area){0, ssd1306_width - 1, 0, ssd1306_n_pages - 1, 0};
+    text_area = (struct render_area){0, ssd1306_width - 1, 0, GRAFICO_BPM_PAGINA_INICIAL - 1, 0};
+    pagina_area = (struct render_area){0, ssd1306_width - 1, 0, 0, 0};
+    calculate_render_area_buffer_length(&frame_area);
+    calculate_render_area_buffer_length(&text_area);
+    calculate_render_area_buffer_length(&pagina_area);
+    ssd1306_init();
+    grafico_bpm_init(&grafico, 30, 130);
+
+    mock_stdio_raw = fopen(caminho, "wb");
+    if (mock_stdio_raw == NULL) {
+        fprintf(stderr, "Falha ao criar %s\n", caminho);
+        return 1;
+    }
+    mock_bus_reset();
+    ssd1306_bytes_enviados = 0;
+    mock_tempo_us = 0;
+    roteiro();
+    uint64_t espera_us = mock_tempo_us;
+    long bytes_espelho = ftell(mock_stdio_raw);
+    // O último quadro reconstruído deve ser o último quadro desenhado
+    espelho_leitor_t leitor;
+    bool confere = conferir_fluxo(&leitor) && ressincronizou;
+    fclose(mock_stdio_raw);
+    mock_stdio_raw = NULL;
+    uint32_t bytes_i2c = ssd1306_bytes_enviados;
+    double barramento_ns = mock_bus_time_ns();
+    uint32_t transacoes = mock_bus.transactions;
+
+    uint32_t renders = 0;
+
+    // Custo de codificação isolado: repete o roteiro só com o codificador (sem barramento)
+    static espelho_t espelho;
+    static uint8_t pacote[ESPELHO_PACOTE_MAX];
+    espelho_init(&espelho);
+    static const uint8_t zeros[ssd1306_buffer_length];
+    double inicio = agora_ns();
+    for (int i = 0; i < 20000; i++) {
+        espelho_codificar(&espelho, (i & 1) ? ssd : zeros, &frame_area, pacote);
+        renders++;
+    }
+    double codificar_quadro_ns = (agora_ns() - inicio) / renders;
+    espelho_init(&espelho);
+    inicio = agora_ns();
+    for (int i = 0; i < 20000; i++) {
+        ssd[(GRAFICO_BPM_PAGINA_INICIAL + (i & 3)) * ssd1306_width + (i & 127)] ^= 1;
+        struct render_area coluna = {i & 127, i & 127, GRAFICO_BPM_PAGINA_INICIAL, ssd1306_n_pages - 1, 4};
+        uint8_t dados[4];
+        for (int p = 0; p < 4; p++) dados[p] = ssd[(GRAFICO_BPM_PAGINA_INICIAL + p) * ssd1306_width + (i & 127)];
+        espelho_codificar(&espelho, dados, &coluna, pacote);
+    }
+    double codificar_coluna_ns = (agora_ns() - inicio) / 20000;
+
+    printf("pacotes espelhados: %u (%u quadros-chave), %u transacoes I2C\n", leitor.quadros, leitor.chaves, transacoes);
+    printf("bytes: espelho %ld (%.1f/pacote), I2C %u (%.1f/transacao de dados)\n",
+           bytes_espelho, (double)bytes_espelho / leitor.quadros, bytes_i2c, (double)bytes_i2c / (transacoes / 2));
+    printf("codificacao no host: %.0f ns por quadro inteiro alterado, %.0f ns por coluna do grafico; "
+           "barramento I2C: %.0f us por transacao de dados em media\n",
+           codificar_quadro_ns, codificar_coluna_ns, barramento_ns / (transacoes / 2) / 1e3);
+    printf("host parado 30 s: %.0f ms de espera no render ao todo, %s\n", espera_us / 1e3,
+           ressincronizou ? "ressincroniza na primeira area apos a volta" : "SEM RESSINCRONIZAR");
+    printf("fluxo em %s: %s\n", caminho, confere ? "reconstrucao confere" : "DIVERGE");
+    return confere ? 0 : 1;
+}
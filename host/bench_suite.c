@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "display.h"
+#include "grafico_bpm.h"
+#include "sinais.h"
+#include "tendencia.h"
+#include "vfc.h"
+#include "formato.h"
+#include "mock_bus.h"
+
+// Suíte de benchmarks dos caminhos quentes do firmware com comparação contra um baseline:
+//   bench_suite --gravar baseline.json [filtro]  grava os resultados atuais como baseline
+//                                                (só as métricas com filtro no nome)
+//   bench_suite baseline.json [margem]           falha (código 1) se algum resultado piorar
+// Só as métricas presentes no baseline são verificadas. Métricas "_bytes" (tráfego no
+// barramento simulado) são determinísticas e não toleram aumento; são as únicas do
+// baseline versionado (host/bench_baseline.json). Métricas "_ns" (tempo de CPU no host)
+// dependem da máquina e do momento: são comparadas só com um baseline gravado na mesma
+// máquina, em unidades da calibração medida em cada execução, com a margem relativa
+// (padrão 0.25 = 25%).
+#define REPETICOES 100        // Cada medição fica com a melhor de N rodadas (reduz ruído)
+#define MARGEM_PADRAO 0.25
+
+typedef struct {
+    const char *nome;
+    double valor;
+} resultado_t;
+
+static resultado_t resultados[24];
+static int n_resultados = 0;
+
+// Impede que o compilador descarte o trabalho medido
+static volatile uint32_t sumidouro;
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void registrar(const char *nome, double valor) {
+    resultados[n_resultados].nome = nome;
+    resultados[n_resultados].valor = valor;
+    n_resultados++;
+}
+
+// Executa a função n vezes e retorna o tempo médio por operação
+static double medir(void (*funcao)(uint32_t), uint32_t n) {
+    double inicio = agora_ns();
+    for (uint32_t i = 0; i < n; i++) {
+        funcao(i);
+    }
+    return (agora_ns() - inicio) / n;
+}
+
+// Calibração: CRC-8 bit a bit de 32 bytes (deslocamentos, desvios e leituras da memória,
+// como os caminhos medidos), nas mesmas rodadas dos benchmarks. Os tempos são comparados
+// com o baseline em unidades dela, o que desconta mudanças de clock e de carga da máquina.
+static uint8_t calibracao_dados[32];
+
+static void op_calibracao(uint32_t i) {
+    calibracao_dados[i & 31] = i;
+    uint8_t crc = 0;
+    for (int k = 0; k < 32; k++) {
+        crc ^= calibracao_dados[k];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+        }
+    }
+    sumidouro += crc;
+}
+
+static uint8_t ssd[ssd1306_buffer_length];
+static struct render_area frame_area;
+static media_bpm_t media;
+static avaliador_alertas_t avaliador;
+static tendencia_t tendencia;
+static vfc_t vfc;
+static grafico_bpm_t grafico;
+
+static void op_draw_string(uint32_t i) {
+    ssd1306_draw_string(ssd, 5, (i & 3) * 8, "BPM 65 Med 65");
+}
+
+static void op_draw_line(uint32_t i) {
+    ssd1306_draw_line(ssd, 0, 63, ssd1306_width - 1, i & 63, i & 1);
+}
+
+static void op_bpm_de_adc(uint32_t i) {
+    sumidouro += sinais_bpm_de_adc(i & 4095);
+}
+
+static void op_media_adicionar(uint32_t i) {
+    sumidouro += sinais_media_adicionar(&media, 40 + (i & 63), 200);
+}
+
+static void op_intervalo_amostragem(uint32_t i) {
+    sumidouro += sinais_intervalo_amostragem_ms(&media, 40 + (i & 63));
+}
+
+// BPM oscilando em torno do limite crítico para exercitar a histerese
+static void op_avaliar_alertas(uint32_t i) {
+    sumidouro += sinais_avaliar_alertas(&avaliador, (i & 256) ? 125 : 70, 2000, i);
+}
+
+static void op_tendencia(uint32_t i) {
+    sumidouro += tendencia_adicionar(&tendencia, 60 + (i >> 10) % 40, 200);
+}
+
+static void op_vfc(uint32_t i) {
+    vfc_adicionar(&vfc, 800 + (i * 37) % 200);
+}
+
+// Mesmo trabalho de process_command() em tarefa-final.c: limpa, escreve 4 linhas e envia
+static void op_quadro_texto(uint32_t i) {
+    (void)i;
+    memset(ssd, 0, ssd1306_buffer_length);
+    ssd1306_draw_string(ssd, 5, 0, "MONITORAMENTO");
+    ssd1306_draw_string(ssd, 5, 8, "BPM 65 Med 65");
+    ssd1306_draw_string(ssd, 5, 16, "Giro Normal");
+    ssd1306_draw_string(ssd, 5, 24, "B Voltar");
+    render_on_display(ssd, &frame_area);
+}
+
+static void op_grafico_coluna(uint32_t i) {
+    grafico_bpm_adicionar(&grafico, 40 + (i & 63));
+    grafico_bpm_atualizar(&grafico, ssd);
+}
+
+// Linha da lista de lembretes ("l 01:23:45 8h"), com snprintf e com formato.h
+static char linha[32];
+
+static void op_linha_snprintf(uint32_t i) {
+    snprintf(linha, sizeof(linha), "%s%02u:%02u:%02u %u%s", (i & 1) ? "l " : "  ",
+             i / 3600, (i % 3600) / 60, i % 60, 8u, "h");
+}
+
+static void op_linha_formato(uint32_t i) {
+    char *p = formato_texto(linha, (i & 1) ? "l " : "  ");
+    p = formato_hhmmss(p, i);
+    p = formato_texto(p, " ");
+    p = formato_decimal(p, 8, 0);
+    formato_fim(formato_texto(p, "h"));
+}
+
+typedef struct {
+    const char *nome;
+    void (*funcao)(uint32_t);
+    uint32_t n;           // Operações por rodada
+} bench_t;
+
+static const bench_t benches[] = {
+    {"calibracao_ns", op_calibracao, 20000}, // Sempre o primeiro
+    {"draw_string_ns", op_draw_string, 20000},
+    {"draw_line_ns", op_draw_line, 5000},
+    {"bpm_de_adc_ns", op_bpm_de_adc, 200000},
+    {"media_movel_ns", op_media_adicionar, 100000},
+    {"intervalo_amostragem_ns", op_intervalo_amostragem, 200000},
+    {"avaliar_alertas_ns", op_avaliar_alertas, 200000},
+    {"tendencia_ns", op_tendencia, 200000},
+    {"vfc_ns", op_vfc, 200000},
+    {"quadro_texto_ns", op_quadro_texto, 5000},   // Serialização do quadro no I2C simulado
+    {"grafico_coluna_ns", op_grafico_coluna, 20000},
+    {"linha_snprintf_ns", op_linha_snprintf, 50000},
+    {"linha_formato_ns", op_linha_formato, 50000},
+};
+#define N_BENCHES (sizeof(benches) / sizeof(benches[0]))
+
+static void executar(void) {
+    frame_area.start_column = 0;
+    frame_area.end_column = ssd1306_width - 1;
+    frame_area.start_page = 0;
+    frame_area.end_page = ssd1306_n_pages - 1;
+    calculate_render_area_buffer_length(&frame_area);
+    ssd1306_init();
+
+    sinais_media_init(&media);
+    sinais_avaliador_init(&avaliador);
+    tendencia_init(&tendencia);
+    vfc_init(&vfc, VFC_JANELA_MAX_MS);
+    grafico_bpm_init(&grafico, 30, 130);
+
+    // As rodadas dos benchmarks são intercaladas e cada um fica com a melhor: um período
+    // de interferência no host afeta uma rodada de cada, e não todas as de um só.
+    // A rodada 0 é de aquecimento (caches e previsor de desvios) e é descartada.
+    double melhor[N_BENCHES];
+    for (size_t b = 0; b < N_BENCHES; b++) {
+        melhor[b] = 1e300;
+    }
+    for (int r = 0; r <= REPETICOES; r++) {
+        for (size_t b = 0; b < N_BENCHES; b++) {
+            double ns = medir(benches[b].funcao, benches[b].n);
+            if (r > 0 && ns < melhor[b]) {
+                melhor[b] = ns;
+            }
+        }
+    }
+    for (size_t b = 0; b < N_BENCHES; b++) {
+        registrar(benches[b].nome, melhor[b]);
+    }
+
+    // Bytes entregues ao I2C simulado por quadro de texto e por coluna nova do gráfico
+    ssd1306_bytes_enviados = 0;
+    op_quadro_texto(0);
+    registrar("quadro_texto_bytes", ssd1306_bytes_enviados);
+
+    ssd1306_bytes_enviados = 0;
+    op_grafico_coluna(0);
+    registrar("grafico_coluna_bytes", ssd1306_bytes_enviados);
+}
+
+static bool gravar_baseline(const char *caminho, const char *filtro) {
+    FILE *f = fopen(caminho, "w");
+    if (f == NULL) {
+        return false;
+    }
+    fprintf(f, "{");
+    const char *separador = "\n";
+    for (int i = 0; i < n_resultados; i++) {
+        if (filtro == NULL || strstr(resultados[i].nome, filtro) != NULL) {
+            fprintf(f, "%s  \"%s\": %.2f", separador, resultados[i].nome, resultados[i].valor);
+            separador = ",\n";
+        }
+    }
+    fprintf(f, "\n}\n");
+    return fclose(f) == 0;
+}
+
+// Leitura mínima do baseline: objeto JSON plano com pares "nome": número
+static bool ler_baseline(const char *texto, const char *nome, double *valor) {
+    char chave[64];
+    snprintf(chave, sizeof(chave), "\"%s\"", nome);
+    const char *p = strstr(texto, chave);
+    if (p == NULL || (p = strchr(p + strlen(chave), ':')) == NULL) {
+        return false;
+    }
+    *valor = strtod(p + 1, NULL);
+    return true;
+}
+
+static char *ler_arquivo(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    if (f == NULL) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *texto = malloc(tamanho + 1);
+    size_t lidos = fread(texto, 1, tamanho, f);
+    texto[lidos] = '\0';
+    fclose(f);
+    return texto;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s [--gravar] baseline.json [margem]\n", argv[0]);
+        return 2;
+    }
+
+    executar();
+
+    if (strcmp(argv[1], "--gravar") == 0) {
+        if (argc < 3 || !gravar_baseline(argv[2], argc > 3 ? argv[3] : NULL)) {
+            fprintf(stderr, "Falha ao gravar o baseline\n");
+            return 2;
+        }
+        for (int i = 0; i < n_resultados; i++) {
+            printf("%-24s %12.2f\n", resultados[i].nome, resultados[i].valor);
+        }
+        printf("Baseline gravado em %s\n", argv[2]);
+        return 0;
+    }
+
+    char *baseline = ler_arquivo(argv[1]);
+    if (baseline == NULL) {
+        fprintf(stderr, "Baseline %s não encontrado (gere com --gravar)\n", argv[1]);
+        return 2;
+    }
+    double margem = (argc > 2) ? atof(argv[2]) : MARGEM_PADRAO;
+
+    // Escala dos tempos: calibração desta execução sobre a do baseline
+    double calibracao_atual = resultados[0].valor;
+    double calibracao_baseline;
+    double escala = ler_baseline(baseline, "calibracao_ns", &calibracao_baseline) && calibracao_baseline > 0
+                    ? calibracao_atual / calibracao_baseline : 1.0;
+
+    int regressoes = 0;
+    printf("%-24s %12s %12s %8s\n", "metrica", "atual", "baseline", "delta");
+    for (int i = 0; i < n_resultados; i++) {
+        double referencia;
+        const char *nome = resultados[i].nome;
+        double atual = resultados[i].valor;
+        if (i == 0 || !ler_baseline(baseline, nome, &referencia)) {
+            printf("%-24s %12.2f %12s %8s\n", nome, atual, "-", "-");
+            continue;
+        }
+
+        bool em_bytes = strstr(nome, "_bytes") != NULL;
+        if (!em_bytes) {
+            referencia *= escala;
+        }
+        double limite = em_bytes ? referencia : referencia * (1.0 + margem);
+        bool regrediu = atual > limite;
+        regressoes += regrediu;
+        printf("%-24s %12.2f %12.2f %+7.1f%%%s\n", nome, atual, referencia,
+               referencia > 0 ? (atual / referencia - 1.0) * 100.0 : 0.0,
+               regrediu ? "  REGRESSAO" : "");
+    }
+    if (escala != 1.0) {
+        printf("tempos do baseline escalados pela calibracao: x%.2f\n", escala);
+    }
+    free(baseline);
+
+    if (regressoes > 0) {
+        printf("%d metrica(s) acima do baseline (margem %.0f%%)\n", regressoes, margem * 100.0);
+        return 1;
+    }
+    printf("Nenhuma regressao (margem %.0f%%)\n", margem * 100.0);
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "telemetria.h"
+#include "telemetria_udp.h"
+
+// Benchmark da telemetria (inc/telemetria.c) com o transporte UDP do host e um receptor
+// local em 127.0.0.1. Cenários com relógio simulado reproduzem o laço principal (volta
+// de 30 ms, sinais a cada 500 ms, um alerta a cada 5 min) com e sem quedas do enlace e
+// medem a latência de fila de cada registro, perdas e bytes por registro. Retorna erro
+// se algum alerta gerado não chegar ao receptor. Por fim, a vazão e o custo de
+// registrar e processar em tempo de CPU.
+#define VOLTA_MS 30
+#define SINAIS_MS 500
+#define ALERTA_A_CADA_MS 300000
+#define ALERTA_DURACAO_MS 20000
+#define CABECALHOS_UDP_IPV4 28
+#define LATENCIAS_MAX 100000
+#define REGISTROS_VAZAO 1000000
+
+typedef struct {
+    const char *nome;
+    uint32_t duracao_s;
+    uint32_t queda_inicio_s;   // Enlace fora em [inicio, fim)
+    uint32_t queda_fim_s;
+} cenario_t;
+
+static const cenario_t cenarios[] = {
+    {"enlace estavel 1h", 3600, 0, 0},
+    {"queda de 10 min", 3600, 1200, 1800},
+    {"queda de 60 min", 7200, 1800, 5400},
+};
+
+// Receptor: confere a sequência dos lotes e calcula a latência de cada registro
+typedef struct {
+    int soquete;
+    uint32_t lotes, registros, alertas, bytes, lacunas;
+    int32_t proxima_sequencia;
+    uint32_t latencias[LATENCIAS_MAX];
+    uint32_t n_latencias;
+    uint32_t latencia_alerta_max;
+} receptor_t;
+
+static receptor_t receptor;
+
+static uint16_t ler_u16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+static uint16_t receptor_abrir(void) {
+    receptor.soquete = socket(AF_INET, SOCK_DGRAM, 0);
+    int tamanho = 1 << 20;
+    setsockopt(receptor.soquete, SOL_SOCKET, SO_RCVBUF, &tamanho, sizeof(tamanho));
+    struct sockaddr_in endereco = {0};
+    endereco.sin_family = AF_INET;
+    endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(receptor.soquete, (struct sockaddr *)&endereco, sizeof(endereco));
+    socklen_t comprimento = sizeof(endereco);
+    getsockname(receptor.soquete, (struct sockaddr *)&endereco, &comprimento);
+    return ntohs(endereco.sin_port);
+}
+
+static void receptor_zerar(void) {
+    int soquete = receptor.soquete;
+    memset(&receptor, 0, sizeof(receptor));
+    receptor.soquete = soquete;
+    receptor.proxima_sequencia = -1;
+}
+
+// Lê todos os datagramas disponíveis; agora_ms é o instante simulado da recepção
+static void receptor_drenar(uint32_t agora_ms) {
+    uint8_t dados[TELEMETRIA_LOTE_MAX_BYTES];
+    ssize_t tamanho;
+    while ((tamanho = recv(receptor.soquete, dados, sizeof(dados), MSG_DONTWAIT)) > 0) {
+        uint8_t n = dados[1];
+        if (dados[0] != TELEMETRIA_MAGICA || tamanho != TELEMETRIA_CABECALHO_BYTES + n * TELEMETRIA_REGISTRO_BYTES) {
+            fprintf(stderr, "lote malformado (%zd bytes)\n", tamanho);
+            exit(1);
+        }
+        uint16_t sequencia = ler_u16(&dados[2]);
+        if (receptor.proxima_sequencia >= 0 && sequencia != receptor.proxima_sequencia) {
+            receptor.lacunas += (uint16_t)(sequencia - receptor.proxima_sequencia);
+        }
+        receptor.proxima_sequencia = (uint16_t)(sequencia + 1);
+        receptor.lotes++;
+        receptor.bytes += tamanho;
+
+        uint32_t instante = ler_u16(&dados[4]) | ((uint32_t)ler_u16(&dados[6]) << 16);
+        for (int i = 0; i < n; i++) {
+            const uint8_t *registro = &dados[TELEMETRIA_CABECALHO_BYTES + i * TELEMETRIA_REGISTRO_BYTES];
+            instante += ler_u16(&registro[1]);
+            uint32_t latencia = agora_ms - instante;
+            if (receptor.n_latencias < LATENCIAS_MAX) {
+                receptor.latencias[receptor.n_latencias++] = latencia;
+            }
+            if (registro[0] == TELEMETRIA_ALERTA) {
+                receptor.alertas++;
+                if (latencia > receptor.latencia_alerta_max) {
+                    receptor.latencia_alerta_max = latencia;
+                }
+            }
+            receptor.registros++;
+        }
+    }
+}
+
+static int comparar(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static bool executar(const cenario_t *cenario, telemetria_t *telemetria) {
+    receptor_zerar();
+    telemetria_init(telemetria);
+    uint32_t alertas_gerados = 0;
+
+    uint32_t proximo_sinal = 0;
+    for (uint32_t t = 0; t < cenario->duracao_s * 1000; t += VOLTA_MS) {
+        telemetria_udp_enlace(!(t >= cenario->queda_inicio_s * 1000 && t < cenario->queda_fim_s * 1000));
+
+        if (t >= proximo_sinal) {
+            telemetria_registrar_sinais(telemetria, t, 60 + (t / 1000) % 30, 2048);
+            proximo_sinal += SINAIS_MS;
+        }
+        // Início e fim de cada alerta, como as transições registradas no laço principal
+        uint32_t fase = t % ALERTA_A_CADA_MS;
+        if (t > 0 && fase < VOLTA_MS) {
+            telemetria_registrar_alerta(telemetria, t, 1, 90);
+            alertas_gerados++;
+        } else if (fase >= ALERTA_DURACAO_MS && fase < ALERTA_DURACAO_MS + VOLTA_MS) {
+            telemetria_registrar_alerta(telemetria, t, 0, 70);
+            alertas_gerados++;
+        }
+
+        telemetria_processar(telemetria, t);
+        receptor_drenar(t);
+    }
+
+    const telemetria_estatisticas_t *e = &telemetria->estatisticas;
+    qsort(receptor.latencias, receptor.n_latencias, sizeof(uint32_t), comparar);
+    double media = 0;
+    for (uint32_t i = 0; i < receptor.n_latencias; i++) {
+        media += receptor.latencias[i];
+    }
+    media /= receptor.n_latencias ? receptor.n_latencias : 1;
+    uint32_t p99 = receptor.n_latencias ? receptor.latencias[receptor.n_latencias * 99 / 100] : 0;
+    uint32_t maxima = receptor.n_latencias ? receptor.latencias[receptor.n_latencias - 1] : 0;
+
+    printf("%s\n", cenario->nome);
+    bool confere = receptor.alertas == alertas_gerados;
+    printf("  registros %u, recebidos %u, decimados %u, lotes descartados %u, lacunas %u\n",
+           e->registros, receptor.registros, e->sinais_decimados, e->lotes_descartados, receptor.lacunas);
+    printf("  alertas gerados %u, recebidos %u, descartados %u%s\n",
+           alertas_gerados, receptor.alertas, e->alertas_descartados, confere ? "" : "  FALHA");
+    printf("  lotes %u, %.1f bytes/registro (%.1f com UDP/IPv4; 1 datagrama por registro: %d)\n",
+           receptor.lotes, (double)receptor.bytes / receptor.registros,
+           (double)(receptor.bytes + receptor.lotes * CABECALHOS_UDP_IPV4) / receptor.registros,
+           CABECALHOS_UDP_IPV4 + TELEMETRIA_CABECALHO_BYTES + TELEMETRIA_REGISTRO_BYTES);
+    printf("  latencia na fila: media %.1f s, p99 %.1f s, max %.1f s; alertas max %.2f s; pendente ao fim: %s\n",
+           media / 1000, p99 / 1000.0, maxima / 1000.0, receptor.latencia_alerta_max / 1000.0,
+           telemetria_pendente(telemetria) ? "sim" : "nao");
+    return confere;
+}
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Vazão: um registro por ms simulado, processar a cada registro e receptor drenado a cada 32
+static void vazao(telemetria_t *telemetria) {
+    receptor_zerar();
+    telemetria_init(telemetria);
+    telemetria_udp_enlace(true);
+
+    double inicio = agora_ns();
+    for (uint32_t i = 0; i < REGISTROS_VAZAO; i++) {
+        telemetria_registrar_sinais(telemetria, i, 65, 2048);
+        telemetria_processar(telemetria, i);
+        if ((i & 31) == 0) {
+            receptor_drenar(i);
+        }
+    }
+    double total_ns = agora_ns() - inicio;
+    receptor_drenar(REGISTROS_VAZAO);
+
+    // Custo de registrar isolado (sem envio); a fila cheia descarta os lotes mais antigos
+    telemetria_init(telemetria);
+    inicio = agora_ns();
+    for (uint32_t i = 0; i < REGISTROS_VAZAO; i++) {
+        telemetria_registrar_sinais(telemetria, i, 65, 2048);
+    }
+    double registrar_ns = (agora_ns() - inicio) / REGISTROS_VAZAO;
+
+    printf("vazao: %.0f registros/s, %.0f lotes/s (CPU, registrar + processar + receptor), "
+           "recebidos %u de %u, envios recusados %u\n",
+           REGISTROS_VAZAO / (total_ns / 1e9), receptor.lotes / (total_ns / 1e9),
+           receptor.registros, REGISTROS_VAZAO, telemetria->estatisticas.envios_recusados);
+    printf("telemetria_registrar_sinais: %.1f ns; RAM da telemetria: %zu bytes\n", registrar_ns, sizeof(telemetria_t));
+}
+
+int main(void) {
+    telemetria_udp_destino(receptor_abrir());
+    static telemetria_t telemetria;
+
+    bool confere = true;
+    for (size_t i = 0; i < sizeof(cenarios) / sizeof(cenarios[0]); i++) {
+        confere &= executar(&cenarios[i], &telemetria);
+    }
+    vazao(&telemetria);
+    return confere ? 0 : 1;
+}
@@ -0,0 +1,340 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "temporizadores.h"
+
+// Benchmark da roda de temporizadores com centenas de lembretes: conferência contra um
+// modelo de força bruta (lista de prazos) em operações aleatórias e custo de inserção,
+// de cancelamento e de avanço/expiração ao longo de uma semana simulada. Retorna erro se
+// a roda divergir do modelo ou a reconstrução dos lembretes após um reinício divergir da
+// roda.
+#define TEMPORIZADORES_BENCH 500
+#define PASSO_MS 30
+#define DURACAO_MS (7ull * 24 * 3600 * 1000)
+
+// Conferência: sementes, operações por semente e temporizadores ativos no máximo
+#define SEMENTES 20
+#define OPERACOES 20000
+#define ATIVOS_MAX 48
+#define EVENTOS_MAX (1 << 20)
+#define DIA_MS (24ull * 3600 * 1000)
+
+// Modelo: um temporizador vence no tick max(prazo arredondado para cima, tick mínimo),
+// sendo o mínimo o tick seguinte ao da inserção ou ao do disparo anterior
+typedef struct {
+    bool ativo;
+    uint64_t prazo_ms;
+    uint32_t periodo_ms;
+    uint64_t tick;
+} modelo_t;
+
+typedef struct {
+    uint64_t tick;
+    uint16_t id;
+} evento_t;
+
+static modelo_t modelo[TEMPORIZADORES_MAX];
+static int modelo_ativos;
+static evento_t eventos[EVENTOS_MAX];
+static uint16_t expirados_roda[EVENTOS_MAX];
+
+static uint64_t aleatorio(uint64_t limite) {
+    uint64_t x = ((uint64_t)rand() << 31) ^ rand();
+    return limite ? x % limite : 0;
+}
+
+static uint64_t tick_vencimento(uint64_t prazo_ms, uint64_t tick_minimo) {
+    uint64_t tick = (prazo_ms + TEMPORIZADORES_TICK_MS - 1) / TEMPORIZADORES_TICK_MS;
+    return tick < tick_minimo ? tick_minimo : tick;
+}
+
+static int comparar_eventos(const void *a, const void *b) {
+    const evento_t *x = a, *y = b;
+    if (x->tick != y->tick) return (x->tick > y->tick) - (x->tick < y->tick);
+    return x->id - y->id;
+}
+
+static int comparar_ids(const void *a, const void *b) {
+    return *(const uint16_t *)a - *(const uint16_t *)b;
+}
+
+// Disparos do modelo até o tick alvo, em ordem de tick
+static int modelo_avancar(uint64_t tick_alvo) {
+    int n = 0;
+    for (int id = 0; id < TEMPORIZADORES_MAX; id++) {
+        modelo_t *m = &modelo[id];
+        while (m->ativo && m->tick <= tick_alvo && n < EVENTOS_MAX) {
+            eventos[n++] = (evento_t){m->tick, id};
+            if (m->periodo_ms > 0) {
+                m->prazo_ms += m->periodo_ms;
+                m->tick = tick_vencimento(m->prazo_ms, m->tick + 1);
+            } else {
+                m->ativo = false;
+                modelo_ativos--;
+            }
+        }
+    }
+    qsort(eventos, n, sizeof(evento_t), comparar_eventos);
+    return n;
+}
+
+// A roda devolve os disparos em ordem de tick e, dentro do mesmo tick, em qualquer ordem
+static bool conferir_disparos(const uint16_t *ids, int n_roda, int n_modelo) {
+    if (n_roda != n_modelo) {
+        printf("  %d disparos na roda, %d no modelo\n", n_roda, n_modelo);
+        return false;
+    }
+    for (int inicio = 0; inicio < n_modelo;) {
+        int fim = inicio;
+        while (fim < n_modelo && eventos[fim].tick == eventos[inicio].tick) fim++;
+        uint16_t grupo[TEMPORIZADORES_MAX * 4];
+        int k = fim - inicio;
+        if (k > (int)(sizeof(grupo) / sizeof(grupo[0]))) return false;
+        memcpy(grupo, &ids[inicio], k * sizeof(uint16_t));
+        qsort(grupo, k, sizeof(uint16_t), comparar_ids);
+        for (int i = 0; i < k; i++) {
+            if (grupo[i] != eventos[inicio + i].id) {
+                printf("  tick %llu: disparo %u na roda, %u no modelo\n",
+                       (unsigned long long)eventos[inicio].tick, grupo[i], eventos[inicio + i].id);
+                return false;
+            }
+        }
+        inicio = fim;
+    }
+    return true;
+}
+
+static bool conferir_estado(const roda_temporizadores_t *roda) {
+    if (roda->quantidade != modelo_ativos) {
+        printf("  %u ativos na roda, %d no modelo\n", roda->quantidade, modelo_ativos);
+        return false;
+    }
+    for (int id = 0; id < TEMPORIZADORES_MAX; id++) {
+        const temporizador_t *t = temporizadores_obter(roda, id);
+        if ((t != NULL) != modelo[id].ativo || (t != NULL && t->prazo_ms != modelo[id].prazo_ms)) {
+            printf("  temporizador %d diverge do modelo (roda %lld, modelo %d %llu)\n", id, t ? (long long)t->prazo_ms : -1LL, modelo[id].ativo, (unsigned long long)modelo[id].prazo_ms);
+            return false;
+        }
+    }
+    // Listagem: todos os ativos, em ordem de prazo
+    static uint16_t ids[TEMPORIZADORES_MAX];
+    int n = temporizadores_listar(roda, ids, TEMPORIZADORES_MAX);
+    if (n != modelo_ativos) return false;
+    for (int i = 1; i < n; i++) {
+        if (roda->temporizadores[ids[i - 1]].prazo_ms > roda->temporizadores[ids[i]].prazo_ms) {
+            printf("  listagem fora de ordem\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Prazos de segundos a ~250 dias (além do alcance da roda e do restante de 32 bits
+// exportado) e avanços de um passo do laço a dias inteiros, forçando cascatas
+static uint64_t distancia_aleatoria(void) {
+    switch (rand() % 5) {
+    case 0: return aleatorio(5000);
+    case 1: return aleatorio(2 * 3600 * 1000);
+    case 2: return aleatorio(9 * 3600 * 1000);
+    case 3: return aleatorio(30 * DIA_MS);
+    default: return aleatorio(250 * DIA_MS);
+    }
+}
+
+static bool conferir_semente(unsigned semente) {
+    static roda_temporizadores_t roda;
+    static temporizador_salvo_t salvos[TEMPORIZADORES_MAX];
+    srand(semente);
+    uint64_t agora = aleatorio(1000 * DIA_MS);
+    temporizadores_init(&roda, agora);
+    memset(modelo, 0, sizeof(modelo));
+    modelo_ativos = 0;
+
+    for (int op = 0; op < OPERACOES; op++) {
+        int escolha = rand() % 100;
+        uint64_t tick_atual = agora / TEMPORIZADORES_TICK_MS;
+
+        if (escolha < 30 && modelo_ativos < ATIVOS_MAX) {
+            uint64_t prazo = agora + distancia_aleatoria();
+            uint32_t periodo = (rand() % 3 == 0) ? 0 : 60000u * (1 + rand() % 480) + (rand() % 2) * aleatorio(1000);
+            int id = temporizadores_adicionar(&roda, prazo, periodo);
+            if (id < 0 || modelo[id].ativo) {
+                printf("  adicionar devolveu %d\n", id);
+                return false;
+            }
+            modelo[id] = (modelo_t){true, prazo, periodo, tick_vencimento(prazo, tick_atual + 1)};
+            modelo_ativos++;
+        } else if (escolha < 40) {
+            int id = rand() % TEMPORIZADORES_MAX;
+            bool esperado = modelo[id].ativo;
+            if (temporizadores_cancelar(&roda, id) != esperado) {
+                printf("  cancelar(%d) divergiu\n", id);
+                return false;
+            }
+            if (esperado) {
+                modelo[id].ativo = false;
+                modelo_ativos--;
+            }
+        } else if (escolha < 42) {
+            // Ida e volta pela persistência: os ativos voltam com ids 0..n-1 em ordem de id
+            int n = temporizadores_exportar(&roda, agora, salvos, TEMPORIZADORES_MAX);
+            temporizadores_init(&roda, agora);
+            temporizadores_importar(&roda, agora, salvos, n);
+            int novo = 0;
+            for (int id = 0; id < TEMPORIZADORES_MAX; id++) {
+                if (!modelo[id].ativo) continue;
+                modelo_t m = modelo[id];
+                uint64_t restante = m.prazo_ms > agora ? m.prazo_ms - agora : 0;
+                if (restante > UINT32_MAX) restante = UINT32_MAX;
+                m.prazo_ms = agora + restante;
+                m.tick = tick_vencimento(m.prazo_ms, tick_atual + 1);
+                modelo[id].ativo = false;
+                modelo[novo++] = m;
+            }
+            if (novo != n) return false;
+        } else {
+            uint64_t passo;
+            switch (rand() % 10) {
+            case 0: passo = aleatorio(3 * DIA_MS); break;
+            case 1: case 2: passo = aleatorio(3600 * 1000); break;
+            default: passo = PASSO_MS; break;
+            }
+            agora += passo;
+            int n_roda = temporizadores_avancar(&roda, agora, expirados_roda, EVENTOS_MAX);
+            int n_modelo = modelo_avancar(agora / TEMPORIZADORES_TICK_MS);
+            if (!conferir_disparos(expirados_roda, n_roda, n_modelo)) return false;
+        }
+        if (!conferir_estado(&roda)) return false;
+    }
+    return true;
+}
+
+// Reinício sem regravar a flash nos disparos: grava no instante 0, a roda segue até o
+// reset em executado ms e fica parada até decorrido ms. temporizadores_descontar() deve
+// chegar ao prazo em que a roda estaria e apontar os disparos perdidos na parada
+// (tempos múltiplos do tick, em que o disparo da roda coincide com o prazo)
+#define REINICIOS 2000
+
+static bool conferir_reinicio(void) {
+    static roda_temporizadores_t roda;
+    temporizador_salvo_t salvos[TEMPORIZADORES_MAX];
+    srand(7);
+
+    for (int r = 0; r < REINICIOS; r++) {
+        int n = 1 + rand() % 16;
+        temporizadores_init(&roda, 0);
+        for (int i = 0; i < n; i++) {
+            uint32_t periodo = (rand() % 8 == 0) ? 0 : 60000u * (1 + rand() % 480);
+            uint64_t prazo = (uint64_t)TEMPORIZADORES_TICK_MS * (1 + aleatorio(8 * 3600));
+            temporizadores_adicionar(&roda, prazo, periodo);
+        }
+        int gravados = temporizadores_exportar(&roda, 0, salvos, TEMPORIZADORES_MAX);
+
+        uint64_t executado = TEMPORIZADORES_TICK_MS * aleatorio(24 * 3600);
+        uint64_t parado = TEMPORIZADORES_TICK_MS * aleatorio(600);
+        temporizadores_avancar(&roda, executado, expirados_roda, EVENTOS_MAX);
+
+        // Perdidos: recorrentes que disparam (uma ou mais vezes) entre o reset e agora
+        int esperados = 0;
+        bool perdeu[TEMPORIZADORES_MAX] = {false};
+        int disparos = temporizadores_avancar(&roda, executado + parado, expirados_roda, EVENTOS_MAX);
+        for (int i = 0; i < disparos; i++) {
+            if (temporizadores_obter(&roda, expirados_roda[i]) != NULL && !perdeu[expirados_roda[i]]) {
+                perdeu[expirados_roda[i]] = true;
+                esperados++;
+            }
+        }
+
+        int perdidos;
+        int restaurados = temporizadores_descontar(salvos, gravados, (uint32_t)(executado + parado), (uint32_t)parado, &perdidos);
+        int ativos = temporizadores_exportar(&roda, executado + parado, salvos + restaurados, TEMPORIZADORES_MAX - restaurados);
+        // Únicos que venceram na parada: ainda ativos na reconstrução, com restante 0
+        int unicos_perdidos = 0;
+        for (int i = 0; i < disparos; i++) {
+            unicos_perdidos += (temporizadores_obter(&roda, expirados_roda[i]) == NULL);
+        }
+
+        if (perdidos != esperados || restaurados != ativos + unicos_perdidos) {
+            printf("  reinicio %d: %d perdidos (esperado %d), %d restaurados (esperado %d)\n",
+                   r, perdidos, esperados, restaurados, ativos + unicos_perdidos);
+            return false;
+        }
+        // Os restantes reconstruídos, como multiconjunto, são os da roda mais os únicos
+        // perdidos (restante 0); exportar segue a ordem dos ids, como a gravação
+        int j = restaurados;
+        for (int i = 0; i < restaurados; i++) {
+            if (salvos[i].restante_ms == 0 && salvos[i].periodo_ms == 0 && unicos_perdidos > 0) {
+                unicos_perdidos--;
+                continue;
+            }
+            if (j >= restaurados + ativos || salvos[i].restante_ms != salvos[j].restante_ms ||
+                salvos[i].periodo_ms != salvos[j].periodo_ms) {
+                printf("  reinicio %d: registro %d diverge da roda\n", r, i);
+                return false;
+            }
+            j++;
+        }
+    }
+    return true;
+}
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void) {
+    int divergencias = 0;
+    for (unsigned semente = 1; semente <= SEMENTES; semente++) {
+        if (!conferir_semente(semente)) {
+            printf("semente %u: roda diverge do modelo\n", semente);
+            divergencias++;
+        }
+    }
+    printf("conferencia: %d sementes x %d operacoes, %d divergencia(s)\n", SEMENTES, OPERACOES, divergencias);
+    if (!conferir_reinicio()) {
+        printf("reinicio: prazos reconstruidos divergem da roda\n");
+        divergencias++;
+    } else {
+        printf("reinicio: %d reconstrucoes conferem com a roda\n", REINICIOS);
+    }
+
+    static roda_temporizadores_t roda;
+    static int ids[TEMPORIZADORES_BENCH];
+    uint16_t expirados[TEMPORIZADORES_MAX];
+    srand(1);
+
+    temporizadores_init(&roda, 0);
+
+    // Períodos de 1 min a 8 h, como os configuráveis na interface
+    double inicio = agora_ns();
+    for (int i = 0; i < TEMPORIZADORES_BENCH; i++) {
+        uint32_t periodo = 60000u * (1 + rand() % 480);
+        ids[i] = temporizadores_adicionar(&roda, periodo, periodo);
+    }
+    double insercao_ns = (agora_ns() - inicio) / TEMPORIZADORES_BENCH;
+
+    // Avança em passos iguais ao laço principal do firmware
+    uint64_t passos = 0, disparos = 0;
+    inicio = agora_ns();
+    for (uint64_t t = 0; t <= DURACAO_MS; t += PASSO_MS) {
+        disparos += temporizadores_avancar(&roda, t, expirados, TEMPORIZADORES_MAX);
+        passos++;
+    }
+    double avanco_ns = agora_ns() - inicio;
+
+    inicio = agora_ns();
+    for (int i = 0; i < TEMPORIZADORES_BENCH; i++) {
+        temporizadores_cancelar(&roda, ids[i]);
+    }
+    double cancelamento_ns = (agora_ns() - inicio) / TEMPORIZADORES_BENCH;
+
+    printf("temporizadores=%d insercao=%.1f ns cancelamento=%.1f ns\n",
+           TEMPORIZADORES_BENCH, insercao_ns, cancelamento_ns);
+    printf("avanco: %llu passos, %llu disparos, %.1f ns/passo, %.1f ns/disparo (incluindo cascatas)\n",
+           (unsigned long long)passos, (unsigned long long)disparos,
+           avanco_ns / passos, avanco_ns / (disparos ? disparos : 1));
+    return divergencias > 0;
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <stdbool.h>
+#include "sinais.h"
+#include "tendencia.h"
+
+// Benchmark do detector de tendência (inc/tendencia.c): custo por amostra e, em cenários
+// sintéticos de deriva, o atraso de detecção a partir do início da deriva e o BPM real
+// nesse instante. Os cenários estáveis contam falsos alarmes. As amostras passam pela
+// mesma cadeia do firmware: conversão do ADC, amostragem adaptativa e média móvel.
+// Retorna erro se algum cenário não gerar exatamente um alerta por episódio.
+#define PASSO_MS 10
+#define RUIDO_BPM 2      // Ruído uniforme de ±RUIDO_BPM no sinal
+#define AMOSTRAS_CUSTO 1000000
+
+typedef struct {
+    const char *nome;
+    uint32_t duracao_s;
+    uint32_t inicio_deriva_s;   // 0 = cenário estável (todo alerta é falso)
+    int episodios;              // Alertas esperados
+    double (*bpm)(double t_s);
+} cenario_t;
+
+static double repouso(double t) { (void)t; return 65; }
+static double passeio(double t) { return 65 + 6 * sin(2 * M_PI * t / 1200); }
+static double subida_lenta(double t) { return t < 600 ? 70 : (t < 1200 ? 70 + 40 * (t - 600) / 600 : 110); }
+static double queda_lenta(double t) { return t < 600 ? 75 : (t < 1200 ? 75 - 30 * (t - 600) / 600 : 45); }
+static double subida_rapida(double t) { return t < 600 ? 65 : (t < 720 ? 65 + 50 * (t - 600) / 120 : 115); }
+static double degrau(double t) { return t < 600 ? 65 : 95; }
+// Degrau, volta ao repouso e novo degrau: dois episódios, e a volta não é uma queda
+static double degrau_repetido(double t) { return (t >= 600 && t < 1500) || t >= 2400 ? 95 : 65; }
+// Escada: o primeiro degrau vira a nova referência e o segundo abre outro episódio
+static double escada(double t) { return t < 600 ? 65 : (t < 3600 ? 90 : 115); }
+
+static const cenario_t cenarios[] = {
+    {"repouso 2h", 7200, 0, 0, repouso},
+    {"oscilacao +-6 20min", 7200, 0, 0, passeio},
+    {"subida 70-110 10min", 3600, 600, 1, subida_lenta},
+    {"queda 75-45 10min", 3600, 600, 1, queda_lenta},
+    {"subida 65-115 2min", 3600, 600, 1, subida_rapida},
+    {"degrau 65-95", 3600, 600, 1, degrau},
+    {"degrau 65-95 2x", 3600, 600, 2, degrau_repetido},
+    {"escada 65-90-115", 5400, 600, 2, escada},
+};
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static bool executar(const cenario_t *cenario) {
+    media_bpm_t media;
+    tendencia_t tendencia;
+    avaliador_alertas_t avaliador;
+    sinais_media_init(&media);
+    tendencia_init(&tendencia);
+    sinais_avaliador_init(&avaliador);
+
+    uint32_t intervalo = INTERVALO_AMOSTRAGEM_MIN_MS, ultima = 0;
+    int alertas = 0;
+    uint32_t primeiro_ms = 0, limite_ms = 0;
+    double bpm_primeiro = 0;
+    srand(2);
+
+    for (uint32_t t = 0; t < cenario->duracao_s * 1000; t += PASSO_MS) {
+        if (t - ultima < intervalo) {
+            continue;
+        }
+        double real = cenario->bpm(t / 1000.0);
+        int bpm = (int)lround(real) + rand() % (2 * RUIDO_BPM + 1) - RUIDO_BPM;
+        uint8_t media_bpm = sinais_media_adicionar(&media, bpm, t - ultima);
+        intervalo = sinais_intervalo_amostragem_ms(&media, bpm);
+
+        // Para comparação: quando o alerta de limite fixo (com histerese) dispararia
+        if (limite_ms == 0 && sinais_avaliar_alertas(&avaliador, media_bpm, 2000, t) != SEM_ALERTA) {
+            limite_ms = t;
+        }
+
+        int sentido = tendencia_adicionar(&tendencia, media_bpm, t - ultima);
+        ultima = t;
+        if (sentido != 0) {
+            if (alertas++ == 0) {
+                primeiro_ms = t;
+                bpm_primeiro = real;
+            }
+        }
+    }
+
+    bool confere = alertas == cenario->episodios;
+    printf("%-22s ", cenario->nome);
+    if (cenario->inicio_deriva_s == 0) {
+        printf("falsos alarmes=%d%s\n", alertas, confere ? "" : "  FALHA");
+        return confere;
+    }
+    if (alertas == 0) {
+        printf("nao detectado");
+    } else {
+        printf("deteccao em %5.1f s (BPM real %5.1f)", (primeiro_ms / 1000.0) - cenario->inicio_deriva_s, bpm_primeiro);
+    }
+    if (limite_ms != 0) {
+        printf(", limite fixo em %5.1f s", (limite_ms / 1000.0) - cenario->inicio_deriva_s);
+    } else {
+        printf(", limite fixo nunca");
+    }
+    printf(", alertas %d de %d esperado(s)%s\n", alertas, cenario->episodios, confere ? "" : "  FALHA");
+    return confere;
+}
+
+int main(void) {
+    // Custo por amostra com BPM variando
+    tendencia_t tendencia;
+    tendencia_init(&tendencia);
+    volatile int sumidouro = 0;
+    double inicio = agora_ns();
+    for (uint32_t i = 0; i < AMOSTRAS_CUSTO; i++) {
+        sumidouro += tendencia_adicionar(&tendencia, 60 + (i >> 10) % 40, 200 + (i & 511));
+    }
+    printf("custo: %.1f ns/amostra\n", (agora_ns() - inicio) / AMOSTRAS_CUSTO);
+
+    bool confere = true;
+    for (size_t i = 0; i < sizeof(cenarios) / sizeof(cenarios[0]); i++) {
+        confere &= executar(&cenarios[i]);
+    }
+    return confere ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "vfc.h"
+
+// Benchmark das métricas de VFC (inc/vfc.c): custo por batimento da atualização
+// incremental e conferência, a cada batimento, contra o cálculo em lote (ponto
+// flutuante sobre a janela inteira) em séries sintéticas de IBI. As métricas
+// incrementais são arredondadas para ms inteiros e pontos percentuais inteiros; a
+// diferença tolerada é de 1 unidade.
+#define BATIMENTOS_CUSTO 2000000
+#define HISTORICO_MAX 20000
+
+typedef struct {
+    const char *nome;
+    uint32_t janela_ms;
+    uint32_t batimentos;
+    uint16_t ibi_base;        // ms
+    uint16_t ruido;           // Variação uniforme de ±ruido ms entre batimentos
+    uint32_t lacuna_a_cada;   // Interrompe o sinal a cada N batimentos (0 = nunca)
+} cenario_t;
+
+static const cenario_t cenarios[] = {
+    {"repouso 65 BPM 5min", 300000, 5000, 923, 20, 0},
+    {"variavel 60 BPM 1min", 60000, 5000, 1000, 120, 0},
+    {"taquicardia 220 BPM", 300000, 8000, 273, 15, 0},      // Anel cheio antes da janela
+    {"lacunas a cada 97", 120000, 5000, 800, 80, 97},
+    {"limites de IBI", 180000, 5000, 1200, 1500, 0},        // Inclui IBIs inválidos
+};
+
+// Histórico para o cálculo de referência: IBIs aceitos e se formam par com o anterior
+static uint16_t historico[HISTORICO_MAX];
+static bool encadeado[HISTORICO_MAX];
+
+typedef struct {
+    double sdnn, rmssd, pnn50;
+} metricas_t;
+
+// Janela de referência: os IBIs mais recentes cuja soma cabe na janela (e na capacidade)
+static metricas_t referencia(uint32_t n, uint32_t janela_ms) {
+    uint32_t inicio = n, soma = 0;
+    while (inicio > 0 && n - inicio < VFC_BATIMENTOS_MAX && soma + historico[inicio - 1] <= janela_ms) {
+        soma += historico[--inicio];
+    }
+
+    metricas_t m = {0, 0, 0};
+    uint32_t quantidade = n - inicio;
+    if (quantidade >= 2) {
+        double media = 0, variancia = 0;
+        for (uint32_t i = inicio; i < n; i++) media += historico[i];
+        media /= quantidade;
+        for (uint32_t i = inicio; i < n; i++) variancia += (historico[i] - media) * (historico[i] - media);
+        m.sdnn = sqrt(variancia / (quantidade - 1));
+    }
+
+    uint32_t pares = 0, nn50 = 0;
+    double soma_d2 = 0;
+    for (uint32_t i = inicio + 1; i < n; i++) {
+        if (!encadeado[i]) continue;
+        double d = (double)historico[i] - historico[i - 1];
+        soma_d2 += d * d;
+        nn50 += fabs(d) > VFC_LIMIAR_NN50_MS;
+        pares++;
+    }
+    if (pares > 0) {
+        m.rmssd = sqrt(soma_d2 / pares);
+        m.pnn50 = 100.0 * nn50 / pares;
+    }
+    return m;
+}
+
+static uint16_t proximo_ibi(const cenario_t *c) {
+    int ibi = c->ibi_base + (rand() % (2 * c->ruido + 1)) - c->ruido;
+    return ibi < 1 ? 1 : ibi;
+}
+
+static bool conferir(const cenario_t *c) {
+    static vfc_t vfc;
+    vfc_init(&vfc, c->janela_ms);
+    srand(7);
+
+    uint32_t n = 0;
+    bool proximo_encadeado = false;
+    double erro_sdnn = 0, erro_rmssd = 0, erro_pnn50 = 0;
+    for (uint32_t b = 0; b < c->batimentos; b++) {
+        if (c->lacuna_a_cada && b % c->lacuna_a_cada == 0) {
+            vfc_interromper(&vfc);
+            proximo_encadeado = false;
+        }
+        uint16_t ibi = proximo_ibi(c);
+        vfc_adicionar(&vfc, ibi);
+        if (ibi < VFC_IBI_MIN_MS || ibi > VFC_IBI_MAX_MS) {
+            proximo_encadeado = false;
+            continue;
+        }
+        historico[n] = ibi;
+        encadeado[n] = proximo_encadeado && n > 0;
+        n++;
+        proximo_encadeado = true;
+
+        metricas_t m = referencia(n, vfc.janela_ms);
+        erro_sdnn = fmax(erro_sdnn, fabs(vfc_sdnn_ms(&vfc) - m.sdnn));
+        erro_rmssd = fmax(erro_rmssd, fabs(vfc_rmssd_ms(&vfc) - m.rmssd));
+        erro_pnn50 = fmax(erro_pnn50, fabs(vfc_pnn50_pct(&vfc) - m.pnn50));
+    }
+
+    bool ok = erro_sdnn < 1.0 && erro_rmssd < 1.0 && erro_pnn50 < 1.0;
+    printf("%-24s %6u %9.3f %9.3f %9.3f  %s\n", c->nome, vfc.quantidade,
+           erro_sdnn, erro_rmssd, erro_pnn50, ok ? "ok" : "DIVERGE");
+    return ok;
+}
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void) {
+    printf("%-24s %6s %9s %9s %9s\n", "cenario", "janela", "erro_sdnn", "erro_rmssd", "erro_pnn50");
+    int divergencias = 0;
+    for (size_t i = 0; i < sizeof(cenarios) / sizeof(cenarios[0]); i++) {
+        divergencias += !conferir(&cenarios[i]);
+    }
+
+    // Custo por batimento (janela de 5 min cheia) e da leitura das três métricas
+    static vfc_t vfc;
+    static uint16_t ibis[4096];
+    vfc_init(&vfc, VFC_JANELA_MAX_MS);
+    srand(3);
+    for (int i = 0; i < 4096; i++) {
+        ibis[i] = 800 + rand() % 200;
+    }
+    double inicio = agora_ns();
+    for (uint32_t i = 0; i < BATIMENTOS_CUSTO; i++) {
+        vfc_adicionar(&vfc, ibis[i & 4095]);
+    }
+    double ns_batimento = (agora_ns() - inicio) / BATIMENTOS_CUSTO;
+
+    volatile uint32_t sumidouro = 0;
+    inicio = agora_ns();
+    for (uint32_t i = 0; i < BATIMENTOS_CUSTO / 10; i++) {
+        sumidouro += vfc_sdnn_ms(&vfc) + vfc_rmssd_ms(&vfc) + vfc_pnn50_pct(&vfc);
+    }
+    double ns_leitura = (agora_ns() - inicio) / (BATIMENTOS_CUSTO / 10);
+
+    printf("\nvfc_adicionar: %.1f ns/batimento; leitura das metricas: %.1f ns; RAM: %zu bytes\n",
+           ns_batimento, ns_leitura, sizeof(vfc_t));
+    return divergencias > 0;
+}
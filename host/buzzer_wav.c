@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "buzzer_padroes.h"
+
+// Renderiza um ciclo de cada padrão do buzzer como WAV (PCM 8 bits, mono), gerando
+// a mesma onda quadrada de 50% que o PWM produz, para verificação auditiva
+#define TAXA_AMOSTRAGEM 22050
+
+static const buzzer_padrao_t *padroes[] = {
+    &buzzer_padrao_cardiaco_alta,
+    &buzzer_padrao_cardiaco_media,
+    &buzzer_padrao_geral_alta,
+    &buzzer_padrao_medicacao_media,
+    &buzzer_padrao_sos,
+};
+
+static void escrever_u32(FILE *arquivo, uint32_t valor) {
+    uint8_t bytes[4] = {valor, valor >> 8, valor >> 16, valor >> 24};
+    fwrite(bytes, 1, 4, arquivo);
+}
+
+static void escrever_u16(FILE *arquivo, uint16_t valor) {
+    uint8_t bytes[2] = {valor, valor >> 8};
+    fwrite(bytes, 1, 2, arquivo);
+}
+
+static uint32_t amostras_da_nota(const buzzer_nota_t *nota) {
+    return (uint32_t)nota->duracao_ms * TAXA_AMOSTRAGEM / 1000;
+}
+
+static int renderizar(const buzzer_padrao_t *padrao, const char *diretorio) {
+    char caminho[512];
+    snprintf(caminho, sizeof(caminho), "%s/%s.wav", diretorio, padrao->nome);
+
+    FILE *arquivo = fopen(caminho, "wb");
+    if (arquivo == NULL) {
+        fprintf(stderr, "Falha ao criar %s\n", caminho);
+        return 1;
+    }
+
+    // Soma das amostras de cada nota, exatamente as que o laço abaixo escreve
+    uint32_t amostras = 0;
+    for (int i = 0; i < padrao->quantidade; i++) {
+        amostras += amostras_da_nota(&padrao->notas[i]);
+    }
+    uint32_t enchimento = amostras & 1; // Blocos RIFF têm tamanho par
+
+    // Cabeçalho RIFF/WAVE com um bloco "fmt " PCM e um bloco "data"
+    fwrite("RIFF", 1, 4, arquivo);
+    escrever_u32(arquivo, 36 + amostras + enchimento);
+    fwrite("WAVEfmt ", 1, 8, arquivo);
+    escrever_u32(arquivo, 16);
+    escrever_u16(arquivo, 1);
+    escrever_u16(arquivo, 1);
+    escrever_u32(arquivo, TAXA_AMOSTRAGEM);
+    escrever_u32(arquivo, TAXA_AMOSTRAGEM);
+    escrever_u16(arquivo, 1);
+    escrever_u16(arquivo, 8);
+    fwrite("data", 1, 4, arquivo);
+    escrever_u32(arquivo, amostras);
+
+    for (int i = 0; i < padrao->quantidade; i++) {
+        const buzzer_nota_t *nota = &padrao->notas[i];
+        uint32_t n = amostras_da_nota(nota);
+        for (uint32_t t = 0; t < n; t++) {
+            uint8_t amostra = 128;
+            if (nota->frequencia_hz != 0) {
+                // Fase em meio período: alterna entre nível alto e baixo
+                uint32_t fase = (uint64_t)t * nota->frequencia_hz * 2 / TAXA_AMOSTRAGEM;
+                amostra = (fase & 1) ? 64 : 192;
+            }
+            fputc(amostra, arquivo);
+        }
+    }
+    if (enchimento) {
+        fputc(0, arquivo);
+    }
+
+    fclose(arquivo);
+    printf("%-16s %5u ms -> %s\n", padrao->nome, buzzer_padrao_duracao_ms(padrao), caminho);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *diretorio = argc > 1 ? argv[1] : ".";
+    int erros = 0;
+
+    for (size_t i = 0; i < sizeof(padroes) / sizeof(padroes[0]); i++) {
+        erros += renderizar(padroes[i], diretorio);
+    }
+    return erros ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <string.h>
+#include "espelho.h"
+
+// Visualizador do espelhamento do display (inc/espelho.h): lê o fluxo do stdio do
+// firmware compilado com -DESPELHO=ON (porta serial em modo raw, p. ex. após
+// `stty -F /dev/ttyACM0 raw`) ou de um arquivo gravado por bench_espelho, reconstrói os
+// quadros e os desenha no terminal com meio-blocos (2 linhas de pixels por caractere).
+//   espelho_viewer [-q] [-p quadro.pbm] [fluxo]    -q: só as estatísticas
+// Texto misturado ao fluxo (dump do rastreamento) é ignorado pelo leitor.
+
+static void desenhar(const uint8_t *quadro) {
+    printf("\033[H");
+    for (int y = 0; y < ssd1306_height; y += 2) {
+        for (int x = 0; x < ssd1306_width; x++) {
+            bool cima = quadro[(y / 8) * ssd1306_width + x] & (1 << (y % 8));
+            bool baixo = quadro[((y + 1) / 8) * ssd1306_width + x] & (1 << ((y + 1) % 8));
+            fputs(cima ? (baixo ? "█" : "▀") : (baixo ? "▄" : " "), stdout);
+        }
+        putchar('\n');
+    }
+    fflush(stdout);
+}
+
+static bool gravar_pbm(const char *caminho, const uint8_t *quadro) {
+    FILE *f = fopen(caminho, "wb");
+    if (f == NULL) {
+        return false;
+    }
+    fprintf(f, "P4\n%d %d\n", ssd1306_width, ssd1306_height);
+    for (int y = 0; y < ssd1306_height; y++) {
+        for (int x = 0; x < ssd1306_width; x += 8) {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; b++) {
+                if (quadro[(y / 8) * ssd1306_width + x + b] & (1 << (y % 8))) {
+                    byte |= 0x80 >> b;
+                }
+            }
+            fputc(byte, f);
+        }
+    }
+    return fclose(f) == 0;
+}
+
+int main(int argc, char **argv) {
+    bool silencioso = false;
+    const char *pbm = NULL;
+    const char *caminho = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            silencioso = true;
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            pbm = argv[++i];
+        } else {
+            caminho = argv[i];
+        }
+    }
+
+    FILE *f = caminho ? fopen(caminho, "rb") : stdin;
+    if (f == NULL) {
+        fprintf(stderr, "Falha ao abrir %s\n", caminho);
+        return 1;
+    }
+
+    static espelho_leitor_t leitor;
+    espelho_leitor_init(&leitor);
+    if (!silencioso) {
+        printf("\033[2J");
+    }
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        if (espelho_leitor_byte(&leitor, c) && !silencioso) {
+            desenhar(leitor.quadro);
+        }
+    }
+
+    printf("quadros %u (%u chave), %u bytes, %.1f bytes/quadro, falhas %u, pacotes perdidos %u\n",
+           leitor.quadros, leitor.chaves, leitor.bytes,
+           leitor.quadros ? (double)leitor.bytes / leitor.quadros : 0.0, leitor.falhas, leitor.lacunas);
+    if (pbm != NULL && !gravar_pbm(pbm, leitor.quadro)) {
+        fprintf(stderr, "Falha ao gravar %s\n", pbm);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,20 @@
+#ifndef mock_hardware_gpio_h
+#define mock_hardware_gpio_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef unsigned int uint;
+
+enum gpio_function { GPIO_FUNC_SPI = 1, GPIO_FUNC_I2C = 3, GPIO_FUNC_PWM = 4, GPIO_FUNC_SIO = 5 };
+
+#define GPIO_IN 0
+#define GPIO_OUT 1
+
+static inline void gpio_init(uint gpio) { (void)gpio; }
+static inline void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_put(uint gpio, bool value) { (void)gpio; (void)value; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+static inline void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+
+#endif
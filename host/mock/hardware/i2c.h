@@ -0,0 +1,17 @@
+#ifndef mock_hardware_i2c_h
+#define mock_hardware_i2c_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "mock_bus.h"
+
+typedef unsigned int uint;
+typedef struct i2c_inst { int id; } i2c_inst_t;
+
+extern i2c_inst_t *i2c1;
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#endif
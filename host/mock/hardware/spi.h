@@ -0,0 +1,16 @@
+#ifndef mock_hardware_spi_h
+#define mock_hardware_spi_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include "mock_bus.h"
+
+typedef unsigned int uint;
+typedef struct spi_inst { int id; } spi_inst_t;
+
+extern spi_inst_t *spi0;
+
+uint spi_init(spi_inst_t *spi, uint baudrate);
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len);
+
+#endif
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <string.h>
+#include "hardware/i2c.h"
+#include "hardware/spi.h"
+#include "pico/stdio_usb.h"
+#include "mock_bus.h"
+
+mock_bus_t mock_bus;
+FILE *mock_stdio_raw = NULL;
+uint64_t mock_tempo_us = 0;
+bool mock_usb_conectado = true;
+uint32_t mock_cdc_livre = UINT32_MAX;
+
+static void mock_usb_out_chars(const char *buf, int len) {
+    fwrite(buf, 1, len, mock_stdio_raw ? mock_stdio_raw : stdout);
+    mock_cdc_livre -= (mock_cdc_livre == UINT32_MAX) ? 0 : len;
+}
+
+stdio_driver_t stdio_usb = { mock_usb_out_chars };
+
+static i2c_inst_t i2c1_inst = { 1 };
+static spi_inst_t spi0_inst = { 0 };
+i2c_inst_t *i2c1 = &i2c1_inst;
+spi_inst_t *spi0 = &spi0_inst;
+
+void mock_bus_reset(void) {
+    uint32_t baudrate = mock_bus.baudrate;
+    memset(&mock_bus, 0, sizeof(mock_bus));
+    mock_bus.baudrate = baudrate;
+}
+
+double mock_bus_time_ns(void) {
+    if (mock_bus.baudrate == 0) {
+        return 0.0;
+    }
+    return (double)mock_bus.bits * 1e9 / mock_bus.baudrate;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    (void)i2c;
+    mock_bus.baudrate = baudrate;
+    return baudrate;
+}
+
+// Cada byte no I2C ocupa 9 bits (8 + ACK); soma o byte de endereço e as condições de start/stop
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)src;
+    mock_bus.bits += 9 * (len + 1) + (nostop ? 1 : 2);
+    mock_bus.bytes += len;
+    mock_bus.transactions++;
+    return (int)len;
+}
+
+uint spi_init(spi_inst_t *spi, uint baudrate) {
+    (void)spi;
+    mock_bus.baudrate = baudrate;
+    return baudrate;
+}
+
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len) {
+    (void)spi; (void)src;
+    mock_bus.bits += 8 * len;
+    mock_bus.bytes += len;
+    mock_bus.transactions++;
+    return (int)len;
+}
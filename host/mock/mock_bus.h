@@ -0,0 +1,20 @@
+#ifndef mock_bus_h
+#define mock_bus_h
+
+#include <stdint.h>
+
+// Barramento simulado: em vez de transmitir, acumula o tempo que cada transferência
+// levaria no fio com o baudrate configurado pelo firmware
+typedef struct {
+    uint32_t baudrate;     // Configurado por i2c_init()/spi_init()
+    uint64_t bits;         // Bits transmitidos (incluindo start/endereço/ACK no I2C)
+    uint64_t bytes;        // Bytes de payload entregues ao barramento
+    uint32_t transactions; // Número de transações
+} mock_bus_t;
+
+extern mock_bus_t mock_bus;
+
+void mock_bus_reset(void);
+double mock_bus_time_ns(void);
+
+#endif
@@ -0,0 +1,3 @@
+#ifndef mock_pico_binary_info_h
+#define mock_pico_binary_info_h
+#endif
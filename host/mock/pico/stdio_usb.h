@@ -0,0 +1,17 @@
+#ifndef mock_pico_stdio_usb_h
+#define mock_pico_stdio_usb_h
+
+// Substituto do pico/stdio_usb.h: o driver grava em mock_stdio_raw e ocupa o FIFO de
+// transmissão simulado em tusb.h
+#include "pico/stdlib.h"
+
+typedef struct {
+    void (*out_chars)(const char *buf, int len);
+} stdio_driver_t;
+
+extern stdio_driver_t stdio_usb;
+extern bool mock_usb_conectado;
+
+static inline bool stdio_usb_connected(void) { return mock_usb_conectado; }
+
+#endif
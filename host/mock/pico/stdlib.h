@@ -0,0 +1,28 @@
+#ifndef mock_pico_stdlib_h
+#define mock_pico_stdlib_h
+
+// Substituto mínimo do pico/stdlib.h para compilar os módulos do firmware no host
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+
+#define _u(x) x##u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+static inline void sleep_ms(uint32_t ms) { (void)ms; }
+
+// Relógio simulado: cada leitura avança 1 us, o suficiente para esperas com prazo terminarem
+extern uint64_t mock_tempo_us;
+static inline uint64_t time_us_64(void) { return ++mock_tempo_us; }
+
+// Saída binária do stdio; os benchmarks podem redirecioná-la para um arquivo
+extern FILE *mock_stdio_raw;
+static inline int putchar_raw(int c) { return fputc(c, mock_stdio_raw ? mock_stdio_raw : stdout); }
+
+#include "hardware/gpio.h"
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef mock_tusb_h
+#define mock_tusb_h
+
+// Substituto do tusb.h: espaço livre no FIFO de transmissão do CDC, ajustado pelos
+// benchmarks para simular um host que lê (ou não) a porta
+#include <stdint.h>
+
+extern uint32_t mock_cdc_livre;
+
+static inline uint32_t tud_cdc_write_available(void) { return mock_cdc_livre; }
+
+#endif
@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+"""Relatório de memória do firmware e verificação de orçamento.
+
+Lê o mapa do linker (tarefa-final.elf.map) e os grafos de chamadas com uso de pilha
+gerados pelo GCC com -fcallgraph-info=su (arquivos .ci ao lado dos objetos) e mostra:
+  - uso de cada região de memória (FLASH, RAM, SCRATCH_X/Y)
+  - flash e RAM por módulo (arquivo-fonte ou membro de biblioteca) e maiores símbolos
+  - profundidade máxima de pilha a partir de main e das interrupções
+Falha (código 1) se algum limite de host/orcamento_memoria.json for excedido.
+
+Uso: orcamento_memoria.py --mapa tarefa-final.elf.map --objetos CMakeFiles/tarefa-final.dir
+                          --orcamento host/orcamento_memoria.json [--simbolos 15]
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+from collections import defaultdict
+
+# O Cortex-M0+ empilha 8 palavras ao entrar em uma exceção
+MOLDURA_EXCECAO = 32
+
+RE_REGIAO = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+RE_SECAO = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?\s*$")
+RE_ENTRADA = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+RE_SIMBOLO = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_.$][\w.$]*)\s*$")
+PREFIXOS = (".text.", ".rodata.", ".data.", ".bss.", ".time_critical.", ".sdata.", ".sbss.",
+            ".uninitialized_data.", ".scratch_x.", ".scratch_y.", ".flashdata.")
+
+
+def nome_modulo(arquivo):
+    """Reduz o caminho do objeto a um nome de módulo legível."""
+    arquivo = arquivo.strip()
+    membro = re.match(r"^(.*?)([^/\\]+\.a)\((.+)\)$", arquivo)
+    if membro:
+        return f"{membro.group(2)}({membro.group(3)})"
+    arquivo = arquivo.replace("\\", "/")
+    arquivo = re.sub(r"\.(obj|o)$", "", arquivo)
+    if "/src/" in arquivo:  # Fontes do Pico SDK compilados junto com o firmware
+        return "pico-sdk/" + arquivo.rsplit("/src/", 1)[1]
+    marcador = ".dir/"
+    if marcador in arquivo:
+        return arquivo.split(marcador, 1)[1]
+    return os.path.basename(arquivo)
+
+
+def nome_simbolo(secao):
+    for prefixo in PREFIXOS:
+        if secao.startswith(prefixo):
+            nome = re.sub(r"^(startup|unlikely|hot|exit)\.?", "", secao[len(prefixo):])
+            return nome or None
+    return None
+
+
+def ler_mapa(caminho):
+    """Retorna as regiões e a lista de contribuições (região, módulo, símbolo, bytes)."""
+    with open(caminho, encoding="utf-8", errors="replace") as f:
+        linhas = f.read().splitlines()
+
+    regioes = {}
+    i = 0
+    while i < len(linhas) and not linhas[i].startswith("Memory Configuration"):
+        i += 1
+    i += 1
+    while i < len(linhas) and not linhas[i].startswith("Linker script and memory map"):
+        m = RE_REGIAO.match(linhas[i])
+        if m and m.group(1) not in ("Name", "*default*"):
+            regioes[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+        i += 1
+
+    def regiao_de(endereco):
+        for nome, (origem, tamanho) in regioes.items():
+            if origem <= endereco < origem + tamanho:
+                return nome
+        return None
+
+    # Nomes longos ficam sozinhos na linha e o endereço segue na próxima: junta as duas
+    unidas = []
+    k = i
+    while k < len(linhas):
+        linha = linhas[k]
+        if (len(linha.split()) == 1 and k + 1 < len(linhas)
+                and linhas[k + 1].strip().startswith("0x") and linhas[k + 1][:1].isspace()):
+            linha = linha.rstrip() + " " + linhas[k + 1].strip()
+            k += 1
+        unidas.append(linha)
+        k += 1
+
+    contribuicoes = []
+    secao_saida = None   # (região da VMA, região da LMA quando diferente)
+    sem_nome = []        # Contribuições da última seção de entrada sem símbolo no nome
+
+    for linha in unidas:
+        if not linha.strip():
+            continue
+
+        # Seção de saída (coluna 0): ".data 0xVMA 0xtamanho load address 0xLMA"
+        if not linha[0].isspace():
+            partes = linha.split(None, 1)
+            m = RE_SECAO.match(" " + partes[1]) if partes[0].startswith(".") and len(partes) > 1 else None
+            secao_saida = None
+            if m and int(m.group(1), 16) != 0 and int(m.group(2), 16) != 0:
+                vma = int(m.group(1), 16)
+                lma = int(m.group(3), 16) if m.group(3) else vma
+                regiao_vma = regiao_de(vma) if regioes else "MEMORIA"
+                regiao_lma = regiao_de(lma) if regioes else "MEMORIA"
+                if regiao_vma is not None:
+                    secao_saida = (regiao_vma, regiao_lma if regiao_lma != regiao_vma else None)
+            continue
+
+        if secao_saida is None:
+            continue
+
+        # Símbolo definido dentro da última seção de entrada
+        m = RE_SIMBOLO.match(linha)
+        if m:
+            for c in sem_nome:
+                c["simbolo"] = m.group(2)
+            sem_nome = []
+            continue
+
+        # Seção de entrada: " .text.nome 0xendereco 0xtamanho arquivo"
+        partes = linha.split(None, 1)
+        if len(partes) < 2:
+            continue
+        m = RE_ENTRADA.match(" " + partes[1])
+        if not m or int(m.group(2), 16) == 0:
+            continue
+        if partes[0] == "*fill*":
+            modulo, simbolo = "(alinhamento)", "*fill*"
+        else:
+            modulo, simbolo = nome_modulo(m.group(3)), nome_simbolo(partes[0])
+        sem_nome = []
+        for regiao in secao_saida:
+            if regiao is not None:
+                contribuicoes.append({"regiao": regiao, "modulo": modulo, "simbolo": simbolo,
+                                      "bytes": int(m.group(2), 16)})
+                if simbolo is None:
+                    sem_nome.append(contribuicoes[-1])
+
+    for c in contribuicoes:
+        if c["simbolo"] is None:
+            c["simbolo"] = "(sem nome)"
+    return regioes, contribuicoes
+
+
+RE_NO = re.compile(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"')
+RE_ARESTA = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"')
+RE_PILHA = re.compile(r"(\d+) bytes \((static|dynamic|dynamic,bounded)\)")
+
+
+def ler_grafo(diretorio):
+    """Lê os .ci: pilha própria de cada função e as chamadas diretas."""
+    pilha = {}
+    qualificador = {}
+    chamadas = defaultdict(set)
+    arquivos = 0
+    for raiz, _, nomes in os.walk(diretorio):
+        for nome in nomes:
+            if not nome.endswith(".ci"):
+                continue
+            arquivos += 1
+            with open(os.path.join(raiz, nome), encoding="utf-8", errors="replace") as f:
+                texto = f.read()
+            for titulo, rotulo in RE_NO.findall(texto):
+                m = RE_PILHA.search(rotulo.replace("\\n", "\n"))
+                if m:
+                    pilha[titulo] = int(m.group(1))
+                    qualificador[titulo] = m.group(2)
+            for origem, destino in RE_ARESTA.findall(texto):
+                chamadas[origem].add(destino)
+    return arquivos, pilha, qualificador, chamadas
+
+
+def resolver(nome, titulos):
+    """Funções static aparecem nos .ci como "arquivo.c:nome"; aceita o nome curto."""
+    if nome in titulos:
+        return nome
+    candidatos = [t for t in titulos if t.endswith(":" + nome)]
+    return candidatos[0] if len(candidatos) == 1 else nome
+
+
+def profundidade(raiz, pilha, chamadas, indiretas):
+    """Pior caso de pilha a partir de raiz: (bytes, caminho, sem_informacao, recursivas)."""
+    memo = {}
+    sem_informacao = set()
+    recursivas = set()
+    visitando = set()
+
+    def visitar(funcao):
+        if funcao in memo:
+            return memo[funcao]
+        if funcao in visitando:
+            recursivas.add(funcao)
+            return 0, [funcao + " (recursão)"]
+        visitando.add(funcao)
+        propria = pilha.get(funcao)
+        if propria is None:
+            sem_informacao.add(funcao)
+            propria = 0
+        destinos = set(chamadas.get(funcao, ())) | set(indiretas.get(funcao, ()))
+        destinos.discard("__indirect_call")
+        pior, caminho = 0, []
+        for destino in sorted(destinos):
+            bytes_destino, caminho_destino = visitar(destino)
+            if bytes_destino > pior:
+                pior, caminho = bytes_destino, caminho_destino
+        visitando.discard(funcao)
+        memo[funcao] = (propria + pior, [f"{funcao} ({propria})"] + caminho)
+        return memo[funcao]
+
+    total, caminho = visitar(raiz)
+    return total, caminho, sem_informacao, recursivas
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Relatório de RAM, flash e pilha com orçamento")
+    parser.add_argument("--mapa", required=True)
+    parser.add_argument("--objetos", required=True, help="diretório com os .ci do alvo")
+    parser.add_argument("--orcamento", required=True)
+    parser.add_argument("--simbolos", type=int, default=15, help="maiores símbolos por região")
+    args = parser.parse_args()
+
+    with open(args.orcamento, encoding="utf-8") as f:
+        orcamento = json.load(f)
+    regioes, contribuicoes = ler_mapa(args.mapa)
+    excedidos = []
+
+    def verificar(descricao, usado, limite):
+        if limite is not None and usado > limite:
+            excedidos.append(f"{descricao}: {usado} > {limite} bytes")
+            return "  EXCEDIDO"
+        return ""
+
+    # Regiões
+    por_regiao = defaultdict(int)
+    for c in contribuicoes:
+        por_regiao[c["regiao"]] += c["bytes"]
+    print(f"{'regiao':<12} {'usado':>9} {'tamanho':>9} {'uso':>6} {'orcamento':>10}")
+    for nome in sorted(por_regiao):
+        tamanho = regioes.get(nome, (0, 0))[1]
+        limite = orcamento.get("regioes", {}).get(nome)
+        uso = f"{100.0 * por_regiao[nome] / tamanho:5.1f}%" if tamanho else "-"
+        print(f"{nome:<12} {por_regiao[nome]:>9} {tamanho:>9} {uso:>6} {limite if limite is not None else '-':>10}"
+              + verificar(f"região {nome}", por_regiao[nome], limite))
+
+    # Módulos
+    por_modulo = defaultdict(lambda: defaultdict(int))
+    for c in contribuicoes:
+        por_modulo[c["modulo"]][c["regiao"]] += c["bytes"]
+    nomes_regioes = sorted(por_regiao)
+    limites_modulos = orcamento.get("modulos", {})
+    print(f"\n{'modulo':<48}" + "".join(f"{r:>11}" for r in nomes_regioes))
+    for modulo in sorted(por_modulo, key=lambda m: -sum(por_modulo[m].values())):
+        alertas = "".join(verificar(f"módulo {modulo} em {r}", por_modulo[modulo][r], limites_modulos.get(modulo, {}).get(r))
+                          for r in nomes_regioes)
+        print(f"{modulo[-48:]:<48}" + "".join(f"{por_modulo[modulo][r]:>11}" for r in nomes_regioes) + alertas)
+    for modulo in limites_modulos:
+        if modulo not in por_modulo:
+            print(f"aviso: módulo {modulo} do orçamento não aparece no mapa")
+
+    # Maiores símbolos
+    for regiao in nomes_regioes:
+        simbolos = sorted((c for c in contribuicoes if c["regiao"] == regiao), key=lambda c: -c["bytes"])
+        print(f"\nmaiores simbolos em {regiao}:")
+        for c in simbolos[:args.simbolos]:
+            print(f"  {c['bytes']:>7}  {c['simbolo']:<40} {c['modulo']}")
+
+    # Pilha
+    config = orcamento.get("pilha", {})
+    arquivos, pilha, qualificador, chamadas = ler_grafo(args.objetos)
+    print(f"\npilha ({arquivos} grafos de chamadas, {len(pilha)} funcoes com pilha conhecida):")
+    if arquivos == 0:
+        excedidos.append("nenhum .ci encontrado (compile com -fcallgraph-info=su)")
+    titulos = set(pilha) | set(chamadas)
+    indiretas = {resolver(origem, titulos): [resolver(d, titulos) for d in destinos]
+                 for origem, destinos in config.get("chamadas_indiretas", {}).items()}
+    sem_informacao, recursivas = set(), set()
+
+    def pior_de(raizes, rotulo):
+        pior, caminho_pior = 0, []
+        for raiz in (resolver(r, titulos) for r in raizes):
+            if raiz not in pilha and raiz not in chamadas:
+                print(f"  aviso: {rotulo} {raiz} não aparece nos grafos")
+                continue
+            total, caminho, sem, rec = profundidade(raiz, pilha, chamadas, indiretas)
+            sem_informacao.update(sem)
+            recursivas.update(rec)
+            print(f"  {rotulo} {raiz}: {total} bytes")
+            if total > pior:
+                pior, caminho_pior = total, caminho
+        return pior, caminho_pior
+
+    pior_raiz, caminho_raiz = pior_de(config.get("raizes", ["main"]), "raiz")
+    pior_irq, caminho_irq = pior_de(config.get("interrupcoes", []), "interrupcao")
+    # Prioridades iguais no NVIC: uma interrupção não preempta outra, só o código principal
+    total = pior_raiz + (pior_irq + MOLDURA_EXCECAO if pior_irq else 0)
+    limite = config.get("limite_bytes")
+    parcelas = f"{pior_raiz} + {pior_irq} (interrupcao) + {MOLDURA_EXCECAO} (moldura) = " if pior_irq else ""
+    print(f"  pior caso: {parcelas}{total} bytes" + (f" de {limite}" if limite else "")
+          + verificar("pilha", total, limite))
+    print("  caminho: " + " -> ".join(caminho_raiz))
+    if caminho_irq:
+        print("  interrupcao: " + " -> ".join(caminho_irq))
+    dinamicas = sorted(f for f, q in qualificador.items() if q == "dynamic")
+    if dinamicas:
+        print("  pilha dinamica (alloca/VLA, contada pelo minimo): " + ", ".join(dinamicas))
+    if sem_informacao:
+        print(f"  sem informacao de pilha (bibliotecas pre-compiladas/assembly, contadas como 0): {len(sem_informacao)}")
+        print("    " + ", ".join(sorted(sem_informacao)[:30]) + (" ..." if len(sem_informacao) > 30 else ""))
+    if recursivas:
+        excedidos.append("recursão no grafo de chamadas: " + ", ".join(sorted(recursivas)))
+
+    if excedidos:
+        print("\nORCAMENTO EXCEDIDO:")
+        for e in excedidos:
+            print("  " + e)
+        return 1
+    print("\nDentro do orcamento")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "sinais.h"
+
+// Compara a amostragem fixa original (média a cada 200 ms, laço acordando a cada 30 ms)
+// com a adaptativa de inc/sinais.c (laço acordando só na próxima amostra, como no
+// monitoramento com o display apagado) reproduzindo o mesmo sinal nas duas:
+//   replay_amostragem              cenário sintético de 700 s
+//   replay_amostragem sinal.csv    linhas "tempo_ms,adc_y" (valor mantido até a próxima)
+// Relata leituras do ADC/despertares, amostras na média, atraso de cada alerta de BPM
+// em relação ao cruzamento do limite crítico e erro da média contra a média exata
+// do sinal na janela de JANELA_MEDIA_MS.
+#define PASSO_MS 10
+#define INTERVALO_FIXO_MS 200
+#define LACO_FIXO_MS 30
+#define MAX_PONTOS 200000
+#define MAX_ALERTAS 32
+
+static uint16_t sinal[MAX_PONTOS]; // ADC a cada PASSO_MS
+static int n_pontos = 0;
+
+// Inverso de sinais_bpm_de_adc() para montar o cenário em BPM
+static uint16_t adc_de_bpm(double bpm) {
+    double adc;
+    if (bpm < 40) {
+        adc = bpm / 0.04 + 12;
+    } else if (bpm <= 80) {
+        adc = 1000 + (bpm - 50) / 0.015 + 33;
+    } else {
+        adc = 3000 + (bpm - 80) / 0.04 + 12;
+    }
+    if (adc < 0) adc = 0;
+    if (adc > 4095) adc = 4095;
+    return (uint16_t)adc;
+}
+
+// Repouso com ruído de ±1 BPM, subida lenta até taquicardia, retorno, repouso e uma
+// queda brusca para bradicardia
+static void gerar_cenario(void) {
+    srand(1);
+    for (int t = 0; t < 700000; t += PASSO_MS) {
+        double bpm = 65;
+        if (t >= 300000 && t < 360000) bpm = 65 + 65.0 * (t - 300000) / 60000;
+        else if (t >= 360000 && t < 400000) bpm = 130;
+        else if (t >= 400000 && t < 420000) bpm = 130 - 65.0 * (t - 400000) / 20000;
+        else if (t >= 600000 && t < 640000) bpm = 35;
+        bpm += (rand() % 3) - 1;
+        sinal[n_pontos++] = adc_de_bpm(bpm);
+    }
+}
+
+static bool ler_csv(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    if (f == NULL) {
+        return false;
+    }
+    unsigned long tempo, adc, tempo_anterior = 0;
+    uint16_t valor = 0;
+    while (fscanf(f, "%lu,%lu", &tempo, &adc) == 2 && n_pontos < MAX_PONTOS) {
+        while (tempo_anterior + PASSO_MS <= tempo && n_pontos > 0 && n_pontos < MAX_PONTOS) {
+            sinal[n_pontos++] = valor;
+            tempo_anterior += PASSO_MS;
+        }
+        valor = (uint16_t)adc;
+        if (n_pontos == 0) {
+            sinal[n_pontos++] = valor;
+            tempo_anterior = tempo;
+        }
+    }
+    fclose(f);
+    return n_pontos > 0;
+}
+
+typedef struct {
+    const char *nome;
+    uint32_t leituras;       // Leituras do ADC (= despertares do laço)
+    uint32_t amostras;       // Amostras entregues à média
+    int alertas;
+    uint32_t atrasos_ms[MAX_ALERTAS];
+    double erro_soma;
+    uint32_t erro_n;
+} resultado_t;
+
+static void reproduzir(resultado_t *r, bool adaptativo) {
+    media_bpm_t media;
+    avaliador_alertas_t avaliador;
+    sinais_media_init(&media);
+    sinais_avaliador_init(&avaliador);
+
+    uint32_t ultima_amostra = 0, intervalo = INTERVALO_FIXO_MS;
+    uint32_t proximo_despertar = 0;
+    bool em_alerta = false;
+    int64_t inicio_critico = -1; // Quando o BPM real cruzou o limite crítico
+    double soma_janela = 0;      // Soma do BPM real nos últimos JANELA_MEDIA_MS
+
+    for (int p = 0; p < n_pontos; p++) {
+        uint32_t t = p * PASSO_MS;
+        uint8_t bpm_real = sinais_bpm_de_adc(sinal[p]);
+
+        // Média exata do sinal na janela, para medir o erro da média amostrada
+        soma_janela += bpm_real;
+        if (p >= JANELA_MEDIA_MS / PASSO_MS) {
+            soma_janela -= sinais_bpm_de_adc(sinal[p - JANELA_MEDIA_MS / PASSO_MS]);
+        }
+
+        bool critico = bpm_real < CRIT_MIN_BPM || bpm_real > CRIT_MAX_BPM;
+        if (critico && inicio_critico < 0) {
+            inicio_critico = t;
+        } else if (!critico && !em_alerta) {
+            inicio_critico = -1;
+        }
+
+        if (t < proximo_despertar) {
+            continue;
+        }
+
+        // Despertar do laço: lê o ADC, amostra se já é hora e avalia os alertas
+        r->leituras++;
+        if (t - ultima_amostra >= intervalo) {
+            sinais_media_adicionar(&media, bpm_real, t - ultima_amostra);
+            if (adaptativo) {
+                intervalo = sinais_intervalo_amostragem_ms(&media, bpm_real);
+            }
+            ultima_amostra = t;
+            r->amostras++;
+        }
+        if (p >= JANELA_MEDIA_MS / PASSO_MS) {
+            r->erro_soma += fabs(media.media - soma_janela / (JANELA_MEDIA_MS / PASSO_MS));
+            r->erro_n++;
+        }
+
+        enum TipoAlerta alerta = sinais_avaliar_alertas(&avaliador, media.media, 2000, t);
+        if (alerta != SEM_ALERTA && !em_alerta) {
+            em_alerta = true;
+            if (r->alertas < MAX_ALERTAS) {
+                r->atrasos_ms[r->alertas++] = inicio_critico >= 0 ? t - (uint32_t)inicio_critico : 0;
+            }
+        } else if (alerta == SEM_ALERTA && em_alerta) {
+            em_alerta = false; // Reconhecimento automático quando o sinal volta
+            inicio_critico = -1;
+        }
+
+        proximo_despertar = adaptativo ? ultima_amostra + intervalo : t + LACO_FIXO_MS;
+    }
+}
+
+static void imprimir(const resultado_t *r, uint32_t duracao_ms) {
+    printf("%-11s leituras=%-6u (%.2f/s) amostras=%-6u (%.2f/s) erro_medio=%.2f BPM alertas:",
+           r->nome, r->leituras, r->leituras * 1000.0 / duracao_ms,
+           r->amostras, r->amostras * 1000.0 / duracao_ms,
+           r->erro_n ? r->erro_soma / r->erro_n : 0.0);
+    for (int i = 0; i < r->alertas; i++) {
+        printf(" %u ms", r->atrasos_ms[i]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        if (!ler_csv(argv[1])) {
+            fprintf(stderr, "Falha ao ler %s\n", argv[1]);
+            return 1;
+        }
+    } else {
+        gerar_cenario();
+    }
+
+    uint32_t duracao_ms = n_pontos * PASSO_MS;
+    resultado_t fixo = { .nome = "fixo" };
+    resultado_t adaptativo = { .nome = "adaptativo" };
+    reproduzir(&fixo, false);
+    reproduzir(&adaptativo, true);
+
+    printf("sinal: %u s, janela da media %u ms, histerese %u ms\n",
+           duracao_ms / 1000, JANELA_MEDIA_MS, TEMPO_HISTERESE_MS);
+    imprimir(&fixo, duracao_ms);
+    imprimir(&adaptativo, duracao_ms);
+    printf("leituras do ADC: %.1f%% da amostragem fixa\n", 100.0 * adaptativo.leituras / fixo.leituras);
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "telemetria.h"
+#include "telemetria_udp.h"
+
+// Mesma interface de inc/telemetria_lwip.c sobre um socket UDP POSIX
+static int soquete = -1;
+static uint16_t porta_destino = 5005;
+static bool enlace = true;
+
+void telemetria_udp_destino(uint16_t porta) {
+    porta_destino = porta;
+}
+
+void telemetria_udp_enlace(bool conectado) {
+    enlace = conectado;
+}
+
+bool telemetria_transporte_init(void) {
+    if (soquete >= 0) {
+        close(soquete);
+    }
+    soquete = socket(AF_INET, SOCK_DGRAM, 0);
+    if (soquete < 0) {
+        return false;
+    }
+    struct sockaddr_in destino = {0};
+    destino.sin_family = AF_INET;
+    destino.sin_port = htons(porta_destino);
+    destino.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return connect(soquete, (struct sockaddr *)&destino, sizeof(destino)) == 0;
+}
+
+void telemetria_transporte_processar(void) {
+}
+
+bool telemetria_transporte_pronto(void) {
+    return enlace;
+}
+
+bool telemetria_transporte_enviar(const uint8_t *dados, uint16_t tamanho) {
+    // Buffer do socket cheio (EAGAIN/ENOBUFS) ou receptor ausente: o lote fica na fila
+    return send(soquete, dados, tamanho, MSG_DONTWAIT) == tamanho;
+}
@@ -0,0 +1,12 @@
+#ifndef telemetria_udp_inc_h
+#define telemetria_udp_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Transporte da telemetria no host: datagramas UDP não bloqueantes para 127.0.0.1.
+// Controles do teste: porta do receptor e enlace simulado (queda do Wi-Fi)
+void telemetria_udp_destino(uint16_t porta);
+void telemetria_udp_enlace(bool conectado);
+
+#endif
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+// Converte o dump do rastreamento (comando 'T' no stdio do firmware) para o formato
+// JSON de trace do Chrome (chrome://tracing ou ui.perfetto.dev):
+//   trace2json < dump.txt > trace.json
+// Os eventos 'E' recebem em args a duração exata em ciclos, calculada pelo SysTick.
+#define PILHA_MAX 32
+#define NOME_MAX 64
+
+typedef struct {
+    char nome[NOME_MAX];
+    uint32_t ciclos;
+} abertura_t;
+
+int main(void) {
+    char linha[256];
+    abertura_t pilha[PILHA_MAX];
+    int profundidade = 0;
+    int dentro = 0, primeiro = 1;
+    uint64_t base_us = 0;
+    uint32_t anterior_us = 0;
+
+    printf("{\"traceEvents\":[\n");
+    while (fgets(linha, sizeof(linha), stdin) != NULL) {
+        if (strncmp(linha, "TRACE BEGIN", 11) == 0) {
+            dentro = 1;
+            continue;
+        }
+        if (strncmp(linha, "TRACE END", 9) == 0) {
+            dentro = 0;
+            continue;
+        }
+        if (!dentro) {
+            continue;
+        }
+
+        unsigned long tempo_us, ciclos;
+        char fase;
+        char nome[NOME_MAX];
+        if (sscanf(linha, "%lu %lu %c %63s", &tempo_us, &ciclos, &fase, nome) != 4) {
+            continue;
+        }
+
+        // O contador de µs gravado tem 32 bits: acumula as voltas (~71 min cada)
+        if ((uint32_t)tempo_us < anterior_us) {
+            base_us += (uint64_t)1 << 32;
+        }
+        anterior_us = (uint32_t)tempo_us;
+
+        printf("%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":1",
+               primeiro ? "" : ",\n", nome, fase, (unsigned long long)(base_us + tempo_us));
+        primeiro = 0;
+
+        if (fase == 'B' && profundidade < PILHA_MAX) {
+            snprintf(pilha[profundidade].nome, NOME_MAX, "%s", nome);
+            pilha[profundidade].ciclos = (uint32_t)ciclos;
+            profundidade++;
+        } else if (fase == 'E' && profundidade > 0 && strcmp(pilha[profundidade - 1].nome, nome) == 0) {
+            // O SysTick é decrescente e tem 24 bits
+            profundidade--;
+            uint32_t duracao = (pilha[profundidade].ciclos - (uint32_t)ciclos) & 0x00FFFFFF;
+            printf(",\"args\":{\"ciclos\":%u}", duracao);
+        }
+        printf("}");
+    }
+    printf("\n]}\n");
+    return 0;
+}
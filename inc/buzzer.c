@@ -0,0 +1,93 @@
+#include "pico/stdlib.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "buzzer.h"
+
+static uint buzzer_pino;
+static uint buzzer_slice;
+static uint32_t contador_hz;                    // Frequência do contador do PWM após o divisor
+static const buzzer_padrao_t *volatile padrao_atual = NULL;
+static volatile uint8_t indice_nota = 0;
+static volatile alarm_id_t alarme_sequenciador = 0;
+
+// Silencia a saída: slice desabilitado e pino no SIO em nível baixo
+static void desligar_saida(void) {
+    pwm_set_gpio_level(buzzer_pino, 0);
+    pwm_set_enabled(buzzer_slice, false);
+    gpio_set_function(buzzer_pino, GPIO_FUNC_SIO);
+}
+
+// Programa o PWM para a nota (onda quadrada com 50% de ciclo) ou silencia nas pausas
+static void aplicar_nota(const buzzer_nota_t *nota) {
+    if (nota->frequencia_hz == 0) {
+        pwm_set_gpio_level(buzzer_pino, 0);
+        return;
+    }
+
+    uint16_t wrap = contador_hz / nota->frequencia_hz - 1;
+    pwm_set_wrap(buzzer_slice, wrap);
+    pwm_set_gpio_level(buzzer_pino, wrap / 2);
+}
+
+// Callback do alarme (contexto de interrupção): aplica a próxima nota e agenda a seguinte.
+// O retorno negativo reagenda em relação ao disparo anterior, evitando deriva no ritmo.
+static int64_t sequenciador_passo(alarm_id_t id, void *user_data) {
+    const buzzer_padrao_t *padrao = padrao_atual;
+    if (padrao == NULL) {
+        return 0;
+    }
+
+    if (indice_nota >= padrao->quantidade) {
+        if (!padrao->repetir) {
+            padrao_atual = NULL;
+            alarme_sequenciador = 0;
+            desligar_saida();
+            return 0;
+        }
+        indice_nota = 0;
+    }
+
+    const buzzer_nota_t *nota = &padrao->notas[indice_nota++];
+    aplicar_nota(nota);
+    return -(int64_t)nota->duracao_ms * 1000;
+}
+
+// Configura o slice do buzzer com o divisor fixo; o pino começa em silêncio
+void buzzer_init(uint pino) {
+    buzzer_pino = pino;
+    buzzer_slice = pwm_gpio_to_slice_num(pino);
+    contador_hz = clock_get_hz(clk_sys) / BUZZER_DIVISOR_PWM;
+
+    pwm_set_clkdiv_int_frac(buzzer_slice, BUZZER_DIVISOR_PWM, 0);
+    gpio_init(pino);
+    gpio_set_dir(pino, GPIO_OUT);
+    gpio_put(pino, 0);
+    desligar_saida();
+}
+
+// Inicia um padrão (substitui o que estiver tocando); pode ser chamada de interrupções
+void buzzer_tocar(const buzzer_padrao_t *padrao) {
+    if (padrao_atual == padrao) {
+        return;
+    }
+    buzzer_parar();
+
+    indice_nota = 0;
+    padrao_atual = padrao;
+    gpio_set_function(buzzer_pino, GPIO_FUNC_PWM);
+    pwm_set_enabled(buzzer_slice, true);
+    alarme_sequenciador = add_alarm_in_us(100, sequenciador_passo, NULL, true);
+}
+
+void buzzer_parar(void) {
+    padrao_atual = NULL;
+    if (alarme_sequenciador > 0) {
+        cancel_alarm(alarme_sequenciador);
+        alarme_sequenciador = 0;
+    }
+    desligar_saida();
+}
+
+bool buzzer_tocando(void) {
+    return padrao_atual != NULL;
+}
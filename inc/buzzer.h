@@ -0,0 +1,19 @@
+#ifndef buzzer_inc_h
+#define buzzer_inc_h
+
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "buzzer_padroes.h"
+
+// Divisor fixo do PWM: com clk_sys de 125 MHz o contador roda a ~7,8 MHz e o
+// wrap de 16 bits cobre frequências a partir de ~120 Hz
+#define BUZZER_DIVISOR_PWM 16
+
+// Sequenciador de padrões do buzzer: as trocas de nota (wrap do PWM) são feitas no
+// callback de um alarme de hardware, sem envolver o laço principal
+void buzzer_init(uint pino);
+void buzzer_tocar(const buzzer_padrao_t *padrao);
+void buzzer_parar(void);
+bool buzzer_tocando(void);
+
+#endif
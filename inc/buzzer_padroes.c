@@ -0,0 +1,80 @@
+#include "buzzer_padroes.h"
+
+// Notas (Hz) usadas nas melodias do anexo F da IEC 60601-1-8
+#define NOTA_C4 262
+#define NOTA_D4 294
+#define NOTA_E4 330
+#define NOTA_G4 392
+#define NOTA_C5 523
+#define NOTA_A5 880
+#define PAUSA 0
+
+// Temporização dos pulsos: duração, espaçamento, pausa entre o 3º e o 4º pulso,
+// pausa entre as duas metades da rajada e intervalo entre rajadas
+#define PULSO_MS 150
+#define ESPACO_MS 100
+#define ESPACO_3_4_MS 350
+#define ESPACO_RAJADA_MS 600
+#define INTERVALO_ALTA_MS 2500
+#define INTERVALO_MEDIA_MS 5000
+
+// Cinco notas de alta prioridade: 3 pulsos, pausa, 2 pulsos
+#define MEIA_RAJADA(n1, n2, n3, n4, n5) \
+    {n1, PULSO_MS}, {PAUSA, ESPACO_MS}, {n2, PULSO_MS}, {PAUSA, ESPACO_MS}, {n3, PULSO_MS}, \
+    {PAUSA, ESPACO_3_4_MS}, {n4, PULSO_MS}, {PAUSA, ESPACO_MS}, {n5, PULSO_MS}
+
+static const buzzer_nota_t notas_cardiaco_alta[] = {
+    MEIA_RAJADA(NOTA_C4, NOTA_E4, NOTA_G4, NOTA_G4, NOTA_C5),
+    {PAUSA, ESPACO_RAJADA_MS},
+    MEIA_RAJADA(NOTA_C4, NOTA_E4, NOTA_G4, NOTA_G4, NOTA_C5),
+    {PAUSA, INTERVALO_ALTA_MS},
+};
+
+// Média prioridade: as três primeiras notas da melodia cardíaca
+static const buzzer_nota_t notas_cardiaco_media[] = {
+    {NOTA_C4, PULSO_MS}, {PAUSA, ESPACO_MS},
+    {NOTA_E4, PULSO_MS}, {PAUSA, ESPACO_MS},
+    {NOTA_G4, PULSO_MS}, {PAUSA, INTERVALO_MEDIA_MS},
+};
+
+static const buzzer_nota_t notas_geral_alta[] = {
+    MEIA_RAJADA(NOTA_C4, NOTA_C4, NOTA_C4, NOTA_C4, NOTA_C4),
+    {PAUSA, ESPACO_RAJADA_MS},
+    MEIA_RAJADA(NOTA_C4, NOTA_C4, NOTA_C4, NOTA_C4, NOTA_C4),
+    {PAUSA, INTERVALO_ALTA_MS},
+};
+
+static const buzzer_nota_t notas_medicacao_media[] = {
+    {NOTA_C5, PULSO_MS}, {PAUSA, ESPACO_MS},
+    {NOTA_D4, PULSO_MS}, {PAUSA, ESPACO_MS},
+    {NOTA_G4, PULSO_MS}, {PAUSA, INTERVALO_MEDIA_MS},
+};
+
+// SOS em Morse: ponto = 1 unidade, traço = 3, espaço entre letras = 3, entre palavras = 7
+#define MORSE_UNIDADE_MS 100
+#define PONTO {NOTA_A5, MORSE_UNIDADE_MS}, {PAUSA, MORSE_UNIDADE_MS}
+#define TRACO {NOTA_A5, 3 * MORSE_UNIDADE_MS}, {PAUSA, MORSE_UNIDADE_MS}
+#define FIM_LETRA {PAUSA, 2 * MORSE_UNIDADE_MS}
+
+static const buzzer_nota_t notas_sos[] = {
+    PONTO, PONTO, PONTO, FIM_LETRA,
+    TRACO, TRACO, TRACO, FIM_LETRA,
+    PONTO, PONTO, PONTO,
+    {PAUSA, 6 * MORSE_UNIDADE_MS},
+};
+
+#define PADRAO(nome, notas) {nome, notas, sizeof(notas) / sizeof((notas)[0]), true}
+
+const buzzer_padrao_t buzzer_padrao_cardiaco_alta = PADRAO("cardiaco_alta", notas_cardiaco_alta);
+const buzzer_padrao_t buzzer_padrao_cardiaco_media = PADRAO("cardiaco_media", notas_cardiaco_media);
+const buzzer_padrao_t buzzer_padrao_geral_alta = PADRAO("geral_alta", notas_geral_alta);
+const buzzer_padrao_t buzzer_padrao_medicacao_media = PADRAO("medicacao_media", notas_medicacao_media);
+const buzzer_padrao_t buzzer_padrao_sos = PADRAO("sos", notas_sos);
+
+uint32_t buzzer_padrao_duracao_ms(const buzzer_padrao_t *padrao) {
+    uint32_t total = 0;
+    for (int i = 0; i < padrao->quantidade; i++) {
+        total += padrao->notas[i].duracao_ms;
+    }
+    return total;
+}
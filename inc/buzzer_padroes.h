@@ -0,0 +1,32 @@
+#ifndef buzzer_padroes_inc_h
+#define buzzer_padroes_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Uma nota do padrão; frequência 0 representa pausa
+typedef struct {
+    uint16_t frequencia_hz;
+    uint16_t duracao_ms;
+} buzzer_nota_t;
+
+// Sequência de notas tocada pelo sequenciador do buzzer
+typedef struct {
+    const char *nome;
+    const buzzer_nota_t *notas;
+    uint8_t quantidade;
+    bool repetir;          // Recomeça ao final (alarmes que exigem confirmação)
+} buzzer_padrao_t;
+
+// Padrões no estilo da IEC 60601-1-8: alta prioridade com 10 pulsos (3 + 2, duas vezes),
+// média prioridade com 3 pulsos, usando as melodias do anexo F da norma.
+extern const buzzer_padrao_t buzzer_padrao_cardiaco_alta;   // Batimento baixo/alto
+extern const buzzer_padrao_t buzzer_padrao_cardiaco_media;  // Tendência do batimento
+extern const buzzer_padrao_t buzzer_padrao_geral_alta;      // Queda detectada
+extern const buzzer_padrao_t buzzer_padrao_medicacao_media; // Alarme do temporizador
+extern const buzzer_padrao_t buzzer_padrao_sos;             // SOS em código Morse
+
+// Duração total de um ciclo do padrão
+uint32_t buzzer_padrao_duracao_ms(const buzzer_padrao_t *padrao);
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef display_inc_h
+#define display_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Backend do display escolhido em tempo de compilação (definido pelo CMake via
+// DISPLAY_BACKEND). Apenas o arquivo do backend selecionado é compilado, então as
+// funções display_bus_* são chamadas diretas, sem ponteiros de função no caminho crítico.
+//   DISPLAY_BACKEND_SSD1306_I2C - SSD1306 via I2C (padrão da BitDogLab)
+//   DISPLAY_BACKEND_SH1106_I2C  - SH1106 via I2C (RAM de 132 colunas, sem endereçamento horizontal)
+//   DISPLAY_BACKEND_SSD1306_SPI - SSD1306 via SPI de 4 fios (pino D/C)
+//   DISPLAY_BACKEND_PBM         - apenas host: emula a GRAM e grava o quadro em arquivo PBM
+#if !defined(DISPLAY_BACKEND_SSD1306_I2C) && !defined(DISPLAY_BACKEND_SH1106_I2C) && \
+    !defined(DISPLAY_BACKEND_SSD1306_SPI) && !defined(DISPLAY_BACKEND_PBM)
+#define DISPLAY_BACKEND_SSD1306_I2C 1
+#endif
+
+#if defined(DISPLAY_BACKEND_SSD1306_I2C)
+#define DISPLAY_BACKEND_NAME "SSD1306/I2C"
+#elif defined(DISPLAY_BACKEND_SH1106_I2C)
+#define DISPLAY_BACKEND_NAME "SH1106/I2C"
+#elif defined(DISPLAY_BACKEND_SSD1306_SPI)
+#define DISPLAY_BACKEND_NAME "SSD1306/SPI"
+#else
+#define DISPLAY_BACKEND_NAME "PBM"
+#endif
+
+#if defined(DISPLAY_BACKEND_SH1106_I2C)
+#define DISPLAY_CONTROLLER_SH1106 1
+#define DISPLAY_COLUMN_OFFSET 2 // O painel de 128 colunas fica centralizado na RAM de 132
+#else
+#define DISPLAY_CONTROLLER_SH1106 0
+#define DISPLAY_COLUMN_OFFSET 0
+#endif
+
+// Pinos e clock do I2C (BitDogLab)
+#define DISPLAY_I2C_SDA 14
+#define DISPLAY_I2C_SCL 15
+#define DISPLAY_I2C_BAUDRATE (400 * 4000)
+
+// Pinos e clock do SPI (SSD1306 suporta até 10 MHz)
+#define DISPLAY_SPI_SCK 18
+#define DISPLAY_SPI_MOSI 19
+#define DISPLAY_SPI_CS 17
+#define DISPLAY_SPI_DC 20
+#define DISPLAY_SPI_RST 16
+#define DISPLAY_SPI_BAUDRATE (10 * 1000 * 1000)
+
+// Total de bytes enviados ao barramento (no I2C inclui o byte de endereço de cada transação)
+extern uint32_t ssd1306_bytes_enviados;
+
+// Interface implementada por cada backend
+void display_bus_init(void);
+void display_bus_write_commands(const uint8_t *commands, int number);
+void display_bus_write_data(const uint8_t *data, int length);
+
+#if defined(DISPLAY_BACKEND_PBM)
+// Grava o conteúdo atual da GRAM emulada como imagem PBM (P4)
+bool display_pbm_save(const char *path);
+#endif
+
+#endif
@@ -0,0 +1,35 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "display.h"
+#include "ssd1306_i2c.h"
+
+// Buffer estático de transmissão: byte de controle seguido dos dados (evita malloc a cada quadro)
+static uint8_t tx_buffer[ssd1306_buffer_length + 1];
+
+// Configura o I2C e os pinos do display
+void display_bus_init(void) {
+    i2c_init(i2c1, DISPLAY_I2C_BAUDRATE);
+    gpio_set_function(DISPLAY_I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(DISPLAY_I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(DISPLAY_I2C_SDA);
+    gpio_pull_up(DISPLAY_I2C_SCL);
+}
+
+// Envia uma sequência de comandos em uma única transação (byte de controle 0x00, Co = 0)
+void display_bus_write_commands(const uint8_t *commands, int number) {
+    tx_buffer[0] = 0x00;
+    memcpy(tx_buffer + 1, commands, number);
+
+    i2c_write_blocking(i2c1, ssd1306_i2c_address, tx_buffer, number + 1, false);
+    ssd1306_bytes_enviados += number + 2;
+}
+
+// Envia dados para a GRAM (byte de controle 0x40)
+void display_bus_write_data(const uint8_t *data, int length) {
+    tx_buffer[0] = 0x40;
+    memcpy(tx_buffer + 1, data, length);
+
+    i2c_write_blocking(i2c1, ssd1306_i2c_address, tx_buffer, length + 1, false);
+    ssd1306_bytes_enviados += length + 2;
+}
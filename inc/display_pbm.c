@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <string.h>
+#include "display.h"
+#include "ssd1306_i2c.h"
+
+// Backend de host: interpreta os comandos do SSD1306 e mantém uma cópia da GRAM,
+// permitindo gravar exatamente o que o painel mostraria em um arquivo PBM.
+static uint8_t gram[ssd1306_buffer_length];
+static uint8_t column_start, column_end = ssd1306_width - 1, column;
+static uint8_t page_start, page_end = ssd1306_n_pages - 1, page;
+
+// Estado do interpretador de comandos (comandos com argumentos chegam em bytes separados)
+static uint8_t pending_command;
+static uint8_t pending_args;
+static uint8_t args[6];
+static uint8_t args_received;
+
+// Quantidade de argumentos de cada comando do SSD1306
+static uint8_t command_args(uint8_t command) {
+    switch (command) {
+        case ssd1306_set_column_address:
+        case ssd1306_set_page_address:
+            return 2;
+        case ssd1306_set_horizontal_scroll:
+        case ssd1306_set_horizontal_scroll | 0x01:
+            return 6;
+        case ssd1306_set_memory_mode:
+        case ssd1306_set_contrast:
+        case ssd1306_set_charge_pump:
+        case ssd1306_set_mux_ratio:
+        case ssd1306_set_display_offset:
+        case ssd1306_set_display_clock_divide_ratio:
+        case ssd1306_set_precharge:
+        case ssd1306_set_common_pin_configuration:
+        case ssd1306_set_vcomh_deselect_level:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Aplica um comando completo (já com seus argumentos) ao estado emulado
+static void apply_command(uint8_t command) {
+    if (command == ssd1306_set_column_address) {
+        column_start = column = args[0];
+        column_end = args[1];
+    } else if (command == ssd1306_set_page_address) {
+        page_start = page = args[0];
+        page_end = args[1];
+    }
+}
+
+void display_bus_init(void) {
+    memset(gram, 0, sizeof(gram));
+}
+
+void display_bus_write_commands(const uint8_t *commands, int number) {
+    for (int i = 0; i < number; i++) {
+        if (pending_args > 0) {
+            args[args_received++] = commands[i];
+            if (args_received == pending_args) {
+                pending_args = 0;
+                apply_command(pending_command);
+            }
+            continue;
+        }
+
+        pending_command = commands[i];
+        pending_args = command_args(commands[i]);
+        args_received = 0;
+        if (pending_args == 0) {
+            apply_command(pending_command);
+        }
+    }
+    ssd1306_bytes_enviados += number;
+}
+
+// Escrita em modo de endereçamento horizontal: avança coluna e, ao fim da janela, página
+void display_bus_write_data(const uint8_t *data, int length) {
+    for (int i = 0; i < length; i++) {
+        gram[page * ssd1306_width + column] = data[i];
+        if (column == column_end) {
+            column = column_start;
+            page = (page == page_end) ? page_start : page + 1;
+        } else {
+            column++;
+        }
+    }
+    ssd1306_bytes_enviados += length;
+}
+
+bool display_pbm_save(const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    fprintf(file, "P4\n%d %d\n", ssd1306_width, ssd1306_height);
+    for (int y = 0; y < ssd1306_height; y++) {
+        uint8_t row[ssd1306_width / 8] = {0};
+        for (int x = 0; x < ssd1306_width; x++) {
+            if (gram[(y / 8) * ssd1306_width + x] & (1 << (y % 8))) {
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        fwrite(row, 1, sizeof(row), file);
+    }
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,40 @@
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "display.h"
+
+// Configura o SPI, os pinos de controle e aplica o pulso de reset no display
+void display_bus_init(void) {
+    spi_init(spi0, DISPLAY_SPI_BAUDRATE);
+    gpio_set_function(DISPLAY_SPI_SCK, GPIO_FUNC_SPI);
+    gpio_set_function(DISPLAY_SPI_MOSI, GPIO_FUNC_SPI);
+
+    gpio_init(DISPLAY_SPI_CS);
+    gpio_set_dir(DISPLAY_SPI_CS, GPIO_OUT);
+    gpio_put(DISPLAY_SPI_CS, 1);
+
+    gpio_init(DISPLAY_SPI_DC);
+    gpio_set_dir(DISPLAY_SPI_DC, GPIO_OUT);
+
+    gpio_init(DISPLAY_SPI_RST);
+    gpio_set_dir(DISPLAY_SPI_RST, GPIO_OUT);
+    gpio_put(DISPLAY_SPI_RST, 0);
+    sleep_ms(1);
+    gpio_put(DISPLAY_SPI_RST, 1);
+}
+
+// No SPI não há byte de controle: o pino D/C indica comando (0) ou dado (1)
+static void spi_transfer(bool data, const uint8_t *buffer, int length) {
+    gpio_put(DISPLAY_SPI_DC, data);
+    gpio_put(DISPLAY_SPI_CS, 0);
+    spi_write_blocking(spi0, buffer, length);
+    gpio_put(DISPLAY_SPI_CS, 1);
+    ssd1306_bytes_enviados += length;
+}
+
+void display_bus_write_commands(const uint8_t *commands, int number) {
+    spi_transfer(false, commands, number);
+}
+
+void display_bus_write_data(const uint8_t *data, int length) {
+    spi_transfer(true, data, length);
+}
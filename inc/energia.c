@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/pll.h"
+#include "hardware/xosc.h"
+#include "hardware/sync.h"
+#include "hardware/structs/scb.h"
+#include "energia.h"
+#include "ssd1306.h"
+
+// Clocks mantidos durante o sono: timer (despertar), IO/pads (botões), PWM (buzzer) e USB (stdio)
+#define ENERGIA_SLEEP_EN0 (CLOCKS_SLEEP_EN0_CLK_SYS_IO_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_PADS_BITS | \
+                           CLOCKS_SLEEP_EN0_CLK_SYS_PWM_BITS)
+#define ENERGIA_SLEEP_EN1 (CLOCKS_SLEEP_EN1_CLK_SYS_TIMER_BITS | CLOCKS_SLEEP_EN1_CLK_SYS_USBCTRL_BITS | \
+                           CLOCKS_SLEEP_EN1_CLK_USB_USBCTRL_BITS)
+
+// Estado do display controlado pela inatividade
+enum estado_display {
+    DISPLAY_NORMAL,
+    DISPLAY_REDUZIDO,
+    DISPLAY_APAGADO
+};
+
+static volatile uint32_t ultima_atividade_ms = 0;
+static volatile enum estado_display estado_display = DISPLAY_NORMAL;
+static volatile bool alarme_disparou = false;
+static energia_estatisticas_t estatisticas;
+
+// Callback do alarme de despertar: apenas sinaliza, o WFI retorna com a interrupção
+static int64_t alarme_despertar(alarm_id_t id, void *user_data) {
+    alarme_disparou = true;
+    return 0;
+}
+
+void energia_init(void) {
+    ultima_atividade_ms = to_ms_since_boot(get_absolute_time());
+    estado_display = DISPLAY_NORMAL;
+}
+
+// Registra interação do usuário (pode ser chamada de dentro de interrupções)
+void energia_registrar_atividade(void) {
+    ultima_atividade_ms = to_ms_since_boot(get_absolute_time());
+}
+
+// Escurece e depois apaga o display conforme o tempo sem atividade (chamada no laço principal)
+void energia_atualizar_display(void) {
+    uint32_t inativo_ms = to_ms_since_boot(get_absolute_time()) - ultima_atividade_ms;
+    enum estado_display novo_estado = DISPLAY_NORMAL;
+
+    if (inativo_ms >= ENERGIA_TEMPO_APAGAR_MS) {
+        novo_estado = DISPLAY_APAGADO;
+    } else if (inativo_ms >= ENERGIA_TEMPO_ESCURECER_MS) {
+        novo_estado = DISPLAY_REDUZIDO;
+    }
+
+    if (novo_estado == estado_display) {
+        return;
+    }
+
+    if (novo_estado == DISPLAY_APAGADO) {
+        ssd1306_display_on(false);
+    } else {
+        if (estado_display == DISPLAY_APAGADO) {
+            ssd1306_display_on(true);
+        }
+        ssd1306_set_contrast_level(novo_estado == DISPLAY_REDUZIDO ? ENERGIA_CONTRASTE_REDUZIDO : ENERGIA_CONTRASTE_NORMAL);
+    }
+    estado_display = novo_estado;
+}
+
+bool energia_display_apagado(void) {
+    return estado_display == DISPLAY_APAGADO;
+}
+
+// Dorme até o fim do intervalo ou até uma interrupção de botão, com os clocks
+// dos periféricos não utilizados desligados durante o WFI
+void energia_dormir_ms(uint32_t ms) {
+    uint64_t inicio = time_us_64();
+
+    alarme_disparou = false;
+    alarm_id_t alarme = add_alarm_in_ms(ms, alarme_despertar, NULL, true);
+
+    // Com as interrupções mascaradas o WFI ainda retorna se alguma estiver pendente,
+    // evitando perder um alarme que dispare entre a verificação e o WFI
+    uint32_t status = save_and_disable_interrupts();
+    if (!alarme_disparou) {
+        clocks_hw->sleep_en0 = ENERGIA_SLEEP_EN0;
+        clocks_hw->sleep_en1 = ENERGIA_SLEEP_EN1;
+        scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+
+        __wfi();
+
+        scb_hw->scr &= ~M0PLUS_SCR_SLEEPDEEP_BITS;
+        clocks_hw->sleep_en0 = ~0u;
+        clocks_hw->sleep_en1 = ~0u;
+    }
+    restore_interrupts(status);
+
+    // Acordou por botão antes do tempo: o alarme não é mais necessário
+    if (alarme > 0 && !alarme_disparou) {
+        cancel_alarm(alarme);
+    }
+
+    estatisticas.tempo_us[ENERGIA_SONO] += time_us_64() - inicio;
+    estatisticas.entradas[ENERGIA_SONO]++;
+}
+
+// Para os osciladores até uma borda de descida em um dos botões. Só deve ser usado
+// quando nada depende do tempo (sem alarme em contagem e sem monitoramento ativo),
+// pois o timer do sistema também para.
+void energia_dormente_ate_botao(const uint *pinos, int quantidade) {
+    estatisticas.entradas[ENERGIA_DORMENTE]++;
+
+    // O modo dormente exige clk_ref/clk_sys vindos do XOSC e as PLLs desligadas
+    clock_configure(clk_ref, CLOCKS_CLK_REF_CTRL_SRC_VALUE_XOSC_CLKSRC, 0, XOSC_MHZ * MHZ, XOSC_MHZ * MHZ);
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLK_REF, 0, XOSC_MHZ * MHZ, XOSC_MHZ * MHZ);
+    clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS, XOSC_MHZ * MHZ, XOSC_MHZ * MHZ);
+    clock_stop(clk_usb);
+    clock_stop(clk_adc);
+    pll_deinit(pll_sys);
+    pll_deinit(pll_usb);
+
+    for (int i = 0; i < quantidade; i++) {
+        gpio_set_dormant_irq_enabled(pinos[i], GPIO_IRQ_EDGE_FALL, true);
+    }
+
+    xosc_dormant();
+
+    for (int i = 0; i < quantidade; i++) {
+        gpio_acknowledge_irq(pinos[i], GPIO_IRQ_EDGE_FALL);
+        gpio_set_dormant_irq_enabled(pinos[i], GPIO_IRQ_EDGE_FALL, false);
+    }
+
+    // Restaura PLLs e a configuração padrão de clocks (os baudrates de I2C/SPI voltam a valer)
+    clocks_init();
+    energia_registrar_atividade();
+}
+
+const energia_estatisticas_t *energia_estatisticas(void) {
+    uint64_t total_us = time_us_64();
+    estatisticas.tempo_us[ENERGIA_ATIVO] = total_us - estatisticas.tempo_us[ENERGIA_SONO];
+    return &estatisticas;
+}
+
+void energia_imprimir_estatisticas(void) {
+    const energia_estatisticas_t *e = energia_estatisticas();
+    printf("ENERGIA ativo %llu us, sono %llu us em %lu entradas, dormente %lu entradas\n",
+           (unsigned long long)e->tempo_us[ENERGIA_ATIVO], (unsigned long long)e->tempo_us[ENERGIA_SONO],
+           (unsigned long)e->entradas[ENERGIA_SONO], (unsigned long)e->entradas[ENERGIA_DORMENTE]);
+}
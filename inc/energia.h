@@ -0,0 +1,41 @@
+#ifndef energia_inc_h
+#define energia_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Estados de energia do sistema
+typedef enum {
+    ENERGIA_ATIVO,     // CPU executando o laço principal
+    ENERGIA_SONO,      // WFI com clocks desnecessários desligados, acorda por timer ou botão
+    ENERGIA_DORMENTE,  // Osciladores parados, acorda apenas por borda nos botões
+    ENERGIA_N_ESTADOS
+} estado_energia_t;
+
+// Tempos de inatividade para escurecer e apagar o display
+#define ENERGIA_TEMPO_ESCURECER_MS 15000
+#define ENERGIA_TEMPO_APAGAR_MS 60000
+#define ENERGIA_CONTRASTE_NORMAL 0xFF
+#define ENERGIA_CONTRASTE_REDUZIDO 0x10
+
+// Instrumentação: tempo acumulado e número de entradas em cada estado, enviados pelo
+// stdio no dump do rastreamento (comando 'T' com -DTRACE=ON). No estado dormente o
+// timer do sistema para e nenhum clock da placa segue contando, então só as entradas
+// são contabilizadas; o tempo dormente é o tempo de relógio menos ativo + sono.
+typedef struct {
+    uint64_t tempo_us[ENERGIA_N_ESTADOS];
+    uint32_t entradas[ENERGIA_N_ESTADOS];
+} energia_estatisticas_t;
+
+void energia_init(void);
+void energia_registrar_atividade(void);
+void energia_atualizar_display(void);
+bool energia_display_apagado(void);
+void energia_dormir_ms(uint32_t ms);
+void energia_dormente_ate_botao(const uint *pinos, int quantidade);
+const energia_estatisticas_t *energia_estatisticas(void);
+// Linha "ENERGIA ..." com as estatísticas pelo stdio
+void energia_imprimir_estatisticas(void);
+
+#endif
@@ -0,0 +1,216 @@
+#include <string.h>
+#include "espelho.h"
+
+static uint16_t fletcher16(const uint8_t *dados, uint16_t tamanho) {
+    uint16_t soma_1 = 0, soma_2 = 0;
+    for (uint16_t i = 0; i < tamanho; i++) {
+        soma_1 = (soma_1 + dados[i]) % 255;
+        soma_2 = (soma_2 + soma_1) % 255;
+    }
+    return (soma_2 << 8) | soma_1;
+}
+
+void espelho_init(espelho_t *espelho) {
+    memset(espelho, 0, sizeof(*espelho));
+    espelho->desde_chave = ESPELHO_CHAVE_A_CADA; // O primeiro pacote é um quadro-chave
+}
+
+// Copia a área (bytes em sequência, página a página) para a posição dela no quadro
+static void aplicar_area(espelho_t *espelho, const uint8_t *dados, const struct render_area *area) {
+    uint8_t *quadro = (uint8_t *)espelho->atual;
+    int largura = area->end_column - area->start_column + 1;
+    for (int pagina = area->start_page; pagina <= area->end_page; pagina++) {
+        memcpy(&quadro[pagina * ssd1306_width + area->start_column], dados, largura);
+        dados += largura;
+    }
+}
+
+static uint8_t *emitir_saltos(uint8_t *p, uint16_t saltos) {
+    while (saltos > 0) {
+        uint16_t n = saltos > 64 ? 64 : saltos;
+        *p++ = ESPELHO_SALTO | (n - 1);
+        saltos -= n;
+    }
+    return p;
+}
+
+// Codifica as palavras de [inicio, fim) que diferem de enviado; fora do intervalo o
+// quadro é igual ao enviado por construção (a área só altera as próprias páginas)
+static uint8_t *codificar_delta(espelho_t *espelho, uint16_t inicio, uint16_t fim, uint8_t *p) {
+    const uint32_t *atual = espelho->atual;
+    const uint32_t *enviado = espelho->enviado;
+    uint16_t saltos = inicio;
+    uint16_t i = inicio;
+
+    while (i < fim) {
+        if (atual[i] == enviado[i]) {
+            saltos++;
+            i++;
+            continue;
+        }
+        p = emitir_saltos(p, saltos);
+        saltos = 0;
+
+        // Repetição: palavras alteradas consecutivas com o mesmo valor (ex.: área apagada)
+        uint16_t n = 1;
+        while (i + n < fim && n < 64 && atual[i + n] == atual[i] && atual[i + n] != enviado[i + n]) {
+            n++;
+        }
+        if (n >= 2) {
+            *p++ = ESPELHO_REPETICAO | (n - 1);
+            memcpy(p, &atual[i], 4);
+            p += 4;
+            i += n;
+            continue;
+        }
+
+        // Literais até uma palavra inalterada ou o início de uma repetição
+        uint16_t primeira = i;
+        n = 0;
+        do {
+            i++;
+            n++;
+        } while (i < fim && n < 128 && atual[i] != enviado[i] &&
+                 !(i + 1 < fim && atual[i + 1] == atual[i] && atual[i + 1] != enviado[i + 1]));
+        *p++ = ESPELHO_LITERAL | (n - 1);
+        memcpy(p, &atual[primeira], n * 4);
+        p += n * 4;
+    }
+    espelho->palavras_comparadas += fim - inicio;
+    return p;
+}
+
+uint16_t espelho_codificar(espelho_t *espelho, const uint8_t *dados, const struct render_area *area, uint8_t *saida) {
+    aplicar_area(espelho, dados, area);
+
+    uint16_t inicio = area->start_page * ESPELHO_PALAVRAS_POR_PAGINA;
+    uint16_t fim = (area->end_page + 1) * ESPELHO_PALAVRAS_POR_PAGINA;
+    bool chave = espelho->desde_chave >= ESPELHO_CHAVE_A_CADA;
+    if (chave) {
+        // Quadro-chave: diferença em relação a um quadro apagado, no quadro inteiro
+        memset(espelho->enviado, 0, sizeof(espelho->enviado));
+        inicio = 0;
+        fim = ESPELHO_PALAVRAS;
+    }
+
+    uint8_t *p = codificar_delta(espelho, inicio, fim, saida + ESPELHO_CABECALHO_BYTES);
+    uint16_t tamanho = p - (saida + ESPELHO_CABECALHO_BYTES);
+    if (tamanho == 0 && !chave) {
+        return 0;
+    }
+    memcpy(&espelho->enviado[inicio], &espelho->atual[inicio], (fim - inicio) * 4);
+
+    saida[0] = ESPELHO_SINCRONISMO_0;
+    saida[1] = ESPELHO_SINCRONISMO_1;
+    saida[2] = espelho->sequencia++;
+    saida[3] = chave ? ESPELHO_CHAVE : ESPELHO_DELTA;
+    saida[4] = tamanho & 0xFF;
+    saida[5] = tamanho >> 8;
+    uint16_t verificacao = fletcher16(saida, ESPELHO_CABECALHO_BYTES + tamanho);
+    *p++ = verificacao & 0xFF;
+    *p++ = verificacao >> 8;
+
+    espelho->desde_chave = chave ? 1 : espelho->desde_chave + 1;
+    return p - saida;
+}
+
+void espelho_pular(espelho_t *espelho, const uint8_t *dados, const struct render_area *area) {
+    aplicar_area(espelho, dados, area);
+    espelho->desde_chave = ESPELHO_CHAVE_A_CADA;
+    espelho->pulados++;
+}
+
+void espelho_leitor_init(espelho_leitor_t *leitor) {
+    memset(leitor, 0, sizeof(*leitor));
+    leitor->proxima_sequencia = -1;
+}
+
+// Aplica um delta ao quadro; false se os comandos passarem do fim do quadro
+static bool aplicar_delta(uint8_t *quadro, const uint8_t *delta, uint16_t tamanho) {
+    const uint8_t *fim_delta = delta + tamanho;
+    uint16_t palavra = 0;
+    while (delta < fim_delta) {
+        uint8_t comando = *delta++;
+        if (comando & ESPELHO_LITERAL) {
+            uint16_t n = (comando & 0x7F) + 1;
+            if (palavra + n > ESPELHO_PALAVRAS || delta + n * 4 > fim_delta) return false;
+            memcpy(&quadro[palavra * 4], delta, n * 4);
+            delta += n * 4;
+            palavra += n;
+        } else if (comando & ESPELHO_REPETICAO) {
+            uint16_t n = (comando & 0x3F) + 1;
+            if (palavra + n > ESPELHO_PALAVRAS || delta + 4 > fim_delta) return false;
+            for (uint16_t i = 0; i < n; i++) {
+                memcpy(&quadro[(palavra + i) * 4], delta, 4);
+            }
+            delta += 4;
+            palavra += n;
+        } else {
+            palavra += (comando & 0x3F) + 1;
+            if (palavra > ESPELHO_PALAVRAS) return false;
+        }
+    }
+    return true;
+}
+
+static bool processar_pacote(espelho_leitor_t *leitor) {
+    const uint8_t *pacote = leitor->pacote;
+    uint16_t tamanho = leitor->esperados - ESPELHO_CABECALHO_BYTES - 2;
+    uint16_t verificacao = pacote[leitor->esperados - 2] | (pacote[leitor->esperados - 1] << 8);
+    if (fletcher16(pacote, ESPELHO_CABECALHO_BYTES + tamanho) != verificacao) {
+        leitor->falhas++;
+        leitor->sincronizado = false;
+        return false;
+    }
+
+    uint8_t sequencia = pacote[2];
+    if (leitor->proxima_sequencia >= 0 && sequencia != leitor->proxima_sequencia) {
+        leitor->lacunas += (uint8_t)(sequencia - leitor->proxima_sequencia);
+        leitor->sincronizado = false;
+    }
+    leitor->proxima_sequencia = (uint8_t)(sequencia + 1);
+
+    bool chave = pacote[3] == ESPELHO_CHAVE;
+    if (chave) {
+        memset(leitor->quadro, 0, sizeof(leitor->quadro));
+        leitor->sincronizado = true;
+        leitor->chaves++;
+    } else if (!leitor->sincronizado) {
+        return false;
+    }
+    if (!aplicar_delta(leitor->quadro, &pacote[ESPELHO_CABECALHO_BYTES], tamanho)) {
+        leitor->falhas++;
+        leitor->sincronizado = false;
+        return false;
+    }
+    leitor->quadros++;
+    leitor->bytes += leitor->esperados;
+    return true;
+}
+
+bool espelho_leitor_byte(espelho_leitor_t *leitor, uint8_t byte) {
+    if (leitor->recebidos == 0 && byte != ESPELHO_SINCRONISMO_0) {
+        return false;
+    }
+    if (leitor->recebidos == 1 && byte != ESPELHO_SINCRONISMO_1) {
+        leitor->recebidos = (byte == ESPELHO_SINCRONISMO_0);
+        return false;
+    }
+    leitor->pacote[leitor->recebidos++] = byte;
+
+    if (leitor->recebidos == ESPELHO_CABECALHO_BYTES) {
+        uint16_t tamanho = leitor->pacote[4] | (leitor->pacote[5] << 8);
+        if (tamanho > ESPELHO_DELTA_MAX) {
+            leitor->falhas++;
+            leitor->recebidos = 0;
+            return false;
+        }
+        leitor->esperados = ESPELHO_CABECALHO_BYTES + tamanho + 2;
+    }
+    if (leitor->recebidos < ESPELHO_CABECALHO_BYTES || leitor->recebidos < leitor->esperados) {
+        return false;
+    }
+
+    leitor->recebidos = 0;
+    return processar_pacote(leitor);
+}
@@ -0,0 +1,78 @@
+#ifndef espelho_inc_h
+#define espelho_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306_i2c.h"
+
+// Espelhamento do display: a cada render_on_display() a área enviada é aplicada a uma
+// cópia da GRAM, comparada palavra a palavra (32 bits) com o último quadro espelhado
+// e a diferença sai codificada em run-length pelo stdio (USB). Com ESPELHO_ENABLED = 0
+// (padrão) nada é compilado; ativado pela opção ESPELHO do CMake. O visualizador no
+// host é host/espelho_viewer.c.
+#ifndef ESPELHO_ENABLED
+#define ESPELHO_ENABLED 0
+#endif
+
+#define ESPELHO_PALAVRAS (ssd1306_buffer_length / 4)
+#define ESPELHO_PALAVRAS_POR_PAGINA (ssd1306_width / 4)
+
+// Pacote: [0-1] ESPELHO_SINCRONISMO  [2] sequência  [3] tipo  [4-5] tamanho do delta
+//         [6..] delta  [fim] Fletcher-16 do cabeçalho e do delta (2 bytes)
+// Tipos: ESPELHO_DELTA em relação ao quadro anterior; ESPELHO_CHAVE em relação a um
+// quadro apagado, enviado a cada ESPELHO_CHAVE_A_CADA pacotes para o visualizador
+// se recuperar de bytes perdidos.
+#define ESPELHO_SINCRONISMO_0 0xA5
+#define ESPELHO_SINCRONISMO_1 0x5A
+#define ESPELHO_DELTA 'D'
+#define ESPELHO_CHAVE 'K'
+#define ESPELHO_CABECALHO_BYTES 6
+#define ESPELHO_CHAVE_A_CADA 64
+
+// Delta: sequência de comandos sobre as palavras do quadro, a partir da palavra 0
+//   00nnnnnn            pula n + 1 palavras inalteradas (1-64)
+//   01nnnnnn + 4 bytes  repete a palavra n + 1 vezes (1-64)
+//   1nnnnnnn + 4(n+1)   n + 1 palavras literais (1-128)
+// Palavras após o último comando ficam inalteradas.
+#define ESPELHO_SALTO 0x00
+#define ESPELHO_REPETICAO 0x40
+#define ESPELHO_LITERAL 0x80
+
+// Pior caso: quadro inteiro em literais
+#define ESPELHO_DELTA_MAX (ESPELHO_PALAVRAS * 4 + ESPELHO_PALAVRAS / 128)
+#define ESPELHO_PACOTE_MAX (ESPELHO_CABECALHO_BYTES + ESPELHO_DELTA_MAX + 2)
+
+typedef struct {
+    uint32_t enviado[ESPELHO_PALAVRAS]; // Último quadro espelhado
+    uint32_t atual[ESPELHO_PALAVRAS];   // GRAM após a última área enviada
+    uint8_t sequencia;
+    uint8_t desde_chave;                // Pacotes desde o último quadro-chave
+    uint32_t palavras_comparadas;       // Estatística: total de comparações
+    uint32_t pulados;                   // Estatística: áreas não espelhadas
+} espelho_t;
+
+void espelho_init(espelho_t *espelho);
+// Aplica a área ao quadro e escreve em saida o pacote com a diferença; retorna o
+// tamanho do pacote (0 se o quadro não mudou)
+uint16_t espelho_codificar(espelho_t *espelho, const uint8_t *dados, const struct render_area *area, uint8_t *saida);
+// Aplica a área ao quadro sem gerar pacote (o host não tinha como recebê-lo); o próximo
+// pacote passa a ser um quadro-chave para o visualizador se ressincronizar
+void espelho_pular(espelho_t *espelho, const uint8_t *dados, const struct render_area *area);
+
+// Leitor de pacotes (host): recebe o fluxo byte a byte, descarta o que não for um
+// pacote íntegro e reconstrói o quadro. Após uma falha espera o próximo quadro-chave.
+typedef struct {
+    uint8_t quadro[ssd1306_buffer_length];
+    uint8_t pacote[ESPELHO_PACOTE_MAX];
+    uint16_t recebidos;
+    uint16_t esperados;
+    bool sincronizado;                  // Quadro válido (houve um quadro-chave desde a última falha)
+    int16_t proxima_sequencia;
+    uint32_t quadros, chaves, bytes, falhas, lacunas;
+} espelho_leitor_t;
+
+void espelho_leitor_init(espelho_leitor_t *leitor);
+// Retorna true quando um pacote completa e leitor->quadro foi atualizado
+bool espelho_leitor_byte(espelho_leitor_t *leitor, uint8_t byte);
+
+#endif
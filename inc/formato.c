@@ -0,0 +1,36 @@
+#include "formato.h"
+
+char *formato_decimal(char *destino, uint32_t valor, uint8_t largura) {
+    // Gera os dígitos do menos significativo para o mais significativo
+    char digitos[FORMATO_DIGITOS_MAX];
+    uint8_t n = 0;
+    do {
+        uint32_t quociente = valor / 10;
+        digitos[n++] = '0' + (char)(valor - quociente * 10);
+        valor = quociente;
+    } while (valor != 0);
+
+    while (largura > n) {
+        *destino++ = '0';
+        largura--;
+    }
+    while (n > 0) {
+        *destino++ = digitos[--n];
+    }
+    return destino;
+}
+
+char *formato_hhmmss(char *destino, uint32_t segundos) {
+    destino = formato_decimal(destino, segundos / 3600, 2);
+    *destino++ = ':';
+    destino = formato_decimal(destino, (segundos % 3600) / 60, 2);
+    *destino++ = ':';
+    return formato_decimal(destino, segundos % 60, 2);
+}
+
+char *formato_texto(char *destino, const char *texto) {
+    while (*texto) {
+        *destino++ = *texto++;
+    }
+    return destino;
+}
@@ -0,0 +1,33 @@
+#ifndef formato_inc_h
+#define formato_inc_h
+
+#include <stdint.h>
+
+// Formatação de inteiros para as linhas do display sem snprintf: sem varargs, sem heap
+// e sem puxar o formatador da biblioteca C para a flash. Cada função escreve a partir
+// de destino e retorna o ponteiro para o fim do que escreveu, para encadear as partes;
+// a linha é terminada com formato_fim().
+//
+//   char *p = formato_texto(linha, "BPM ");
+//   p = formato_decimal(p, bpm, 0);
+//   formato_fim(p);
+//
+// O chamador garante o espaço: um uint32_t ocupa no máximo FORMATO_DIGITOS_MAX dígitos.
+#define FORMATO_DIGITOS_MAX 10
+
+// Decimal sem sinal com pelo menos "largura" dígitos, completando com zeros à esquerda
+// (equivale a "%0*u"; largura 0 ou 1 equivale a "%u")
+char *formato_decimal(char *destino, uint32_t valor, uint8_t largura);
+
+// Duração em segundos como HH:MM:SS (equivale a "%02u:%02u:%02u"; as horas crescem
+// além de 2 dígitos se necessário)
+char *formato_hhmmss(char *destino, uint32_t segundos);
+
+// Copia o texto sem o terminador
+char *formato_texto(char *destino, const char *texto);
+
+static inline void formato_fim(char *destino) {
+    *destino = '\0';
+}
+
+#endif
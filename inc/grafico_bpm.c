@@ -0,0 +1,128 @@
+#include <string.h>
+#include "grafico_bpm.h"
+
+// Converte um valor de BPM na linha (y) correspondente dentro da área do gráfico
+static int valor_para_linha(const grafico_bpm_t *grafico, uint8_t valor) {
+    if (valor < grafico->valor_min) valor = grafico->valor_min;
+    if (valor > grafico->valor_max) valor = grafico->valor_max;
+
+    int escala = (valor - grafico->valor_min) * (GRAFICO_BPM_ALTURA - 1) / (grafico->valor_max - grafico->valor_min);
+    return ssd1306_height - 1 - escala;
+}
+
+// Apaga uma coluna da área do gráfico no buffer do display
+static void apagar_coluna(uint8_t *ssd, uint8_t x) {
+    for (int pagina = GRAFICO_BPM_PAGINA_INICIAL; pagina < ssd1306_n_pages; pagina++) {
+        ssd[pagina * ssd1306_width + x] = 0;
+    }
+}
+
+// Desenha a amostra da coluna x como um segmento vertical ligado à amostra anterior
+static void rasterizar_coluna(const grafico_bpm_t *grafico, uint8_t *ssd, uint8_t x) {
+    apagar_coluna(ssd, x);
+    if (!grafico->cheio && x >= grafico->coluna) {
+        return; // Coluna ainda sem amostra
+    }
+
+    int y = valor_para_linha(grafico, grafico->amostras[x]);
+    int y_anterior = (x > 0) ? valor_para_linha(grafico, grafico->amostras[x - 1]) : y;
+    int y_0 = y < y_anterior ? y : y_anterior;
+    int y_1 = y < y_anterior ? y_anterior : y;
+
+    ssd1306_draw_line(ssd, x, y_0, x, y_1, true);
+}
+
+// Envia ao display apenas as colunas [x_0, x_1] da área do gráfico
+static void enviar_colunas(uint8_t *ssd, uint8_t x_0, uint8_t x_1) {
+    uint8_t buffer[GRAFICO_BPM_PAGINAS * 2];
+    struct render_area area = {
+        .start_column = x_0,
+        .end_column = x_1,
+        .start_page = GRAFICO_BPM_PAGINA_INICIAL,
+        .end_page = ssd1306_n_pages - 1
+    };
+    calculate_render_area_buffer_length(&area);
+
+    // No modo de endereçamento horizontal os bytes seguem coluna a coluna em cada página
+    int i = 0;
+    for (int pagina = GRAFICO_BPM_PAGINA_INICIAL; pagina < ssd1306_n_pages; pagina++) {
+        for (int x = x_0; x <= x_1; x++) {
+            buffer[i++] = ssd[pagina * ssd1306_width + x];
+        }
+    }
+
+    render_on_display(buffer, &area);
+}
+
+// Inicializa o gráfico vazio com a faixa de valores exibida
+void grafico_bpm_init(grafico_bpm_t *grafico, uint8_t valor_min, uint8_t valor_max) {
+    memset(grafico, 0, sizeof(*grafico));
+    grafico->valor_min = valor_min;
+    grafico->valor_max = valor_max;
+}
+
+// Registra uma nova amostra; o envio ao display fica para grafico_bpm_atualizar()
+void grafico_bpm_adicionar(grafico_bpm_t *grafico, uint8_t valor) {
+    grafico->amostras[grafico->coluna] = valor;
+    grafico->coluna = (grafico->coluna + 1) % GRAFICO_BPM_LARGURA;
+    if (grafico->coluna == 0) {
+        grafico->cheio = true;
+    }
+    if (grafico->pendentes < GRAFICO_BPM_LARGURA) {
+        grafico->pendentes++;
+    }
+}
+
+// Envia somente as colunas novas (e a coluna de apagamento à frente do cursor)
+void grafico_bpm_atualizar(grafico_bpm_t *grafico, uint8_t *ssd) {
+    if (grafico->pendentes == 0) {
+        return;
+    }
+    if (grafico->pendentes > GRAFICO_BPM_MAX_PENDENTES) {
+        grafico_bpm_redesenhar(grafico, ssd);
+        return;
+    }
+
+    uint32_t bytes_inicio = ssd1306_bytes_enviados;
+    uint8_t x = (grafico->coluna + GRAFICO_BPM_LARGURA - grafico->pendentes) % GRAFICO_BPM_LARGURA;
+
+    while (grafico->pendentes > 0) {
+        uint8_t proxima = (x + 1) % GRAFICO_BPM_LARGURA;
+        rasterizar_coluna(grafico, ssd, x);
+        apagar_coluna(ssd, proxima);
+
+        if (proxima > x) {
+            enviar_colunas(ssd, x, proxima);
+        } else {
+            enviar_colunas(ssd, x, x);
+            enviar_colunas(ssd, proxima, proxima);
+        }
+
+        x = proxima;
+        grafico->pendentes--;
+    }
+
+    grafico->bytes_ultima_atualizacao = ssd1306_bytes_enviados - bytes_inicio;
+}
+
+// Redesenha o gráfico inteiro (ao entrar na tela ou após muitas colunas pendentes)
+void grafico_bpm_redesenhar(grafico_bpm_t *grafico, uint8_t *ssd) {
+    uint32_t bytes_inicio = ssd1306_bytes_enviados;
+
+    for (int x = 0; x < GRAFICO_BPM_LARGURA; x++) {
+        rasterizar_coluna(grafico, ssd, x);
+    }
+    apagar_coluna(ssd, grafico->coluna);
+
+    struct render_area area = {
+        .start_column = 0,
+        .end_column = ssd1306_width - 1,
+        .start_page = GRAFICO_BPM_PAGINA_INICIAL,
+        .end_page = ssd1306_n_pages - 1
+    };
+    calculate_render_area_buffer_length(&area);
+    render_on_display(ssd + GRAFICO_BPM_PAGINA_INICIAL * ssd1306_width, &area);
+
+    grafico->pendentes = 0;
+    grafico->bytes_ultima_atualizacao = ssd1306_bytes_enviados - bytes_inicio;
+}
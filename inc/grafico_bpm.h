@@ -0,0 +1,39 @@
+#ifndef grafico_bpm_inc_h
+#define grafico_bpm_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// Área do gráfico: metade inferior do display (páginas 4-7, linhas 32-63)
+#define GRAFICO_BPM_LARGURA ssd1306_width
+#define GRAFICO_BPM_PAGINA_INICIAL 4
+#define GRAFICO_BPM_PAGINAS (ssd1306_n_pages - GRAFICO_BPM_PAGINA_INICIAL)
+#define GRAFICO_BPM_ALTURA (GRAFICO_BPM_PAGINAS * ssd1306_page_height)
+
+// Gráfico de tendência em modo "varredura" (como em monitores cardíacos): cada nova
+// amostra ocupa a coluna seguinte e apenas essa coluna (mais a coluna de apagamento
+// à frente) é enviada ao display. Custo no barramento por atualização com o backend
+// SSD1306 via I2C (comandos em uma transação; conta o byte de endereço):
+//   - coluna nova: (1 + 1 + 6 comandos) + (1 + 1 + 2 colunas x 4 páginas) = 18 bytes
+//   - gráfico inteiro (páginas 4-7): 8 + (1 + 1 + 512) = 522 bytes
+//   - quadro inteiro (redesenho ingênuo): 8 + (1 + 1 + 1024) = 1034 bytes
+typedef struct {
+    uint8_t amostras[GRAFICO_BPM_LARGURA]; // Anel de amostras (índice = coluna)
+    uint8_t coluna;                        // Próxima coluna a ser escrita
+    uint8_t pendentes;                     // Colunas ainda não enviadas ao display
+    bool cheio;                            // Já completou uma volta no anel
+    uint8_t valor_min;                     // Valor mapeado na linha inferior
+    uint8_t valor_max;                     // Valor mapeado na linha superior
+    uint32_t bytes_ultima_atualizacao;     // Bytes enviados na última atualização
+} grafico_bpm_t;
+
+// Acima deste número de colunas pendentes o redesenho do gráfico inteiro é mais barato
+#define GRAFICO_BPM_MAX_PENDENTES (522 / 18)
+
+void grafico_bpm_init(grafico_bpm_t *grafico, uint8_t valor_min, uint8_t valor_max);
+void grafico_bpm_adicionar(grafico_bpm_t *grafico, uint8_t valor);
+void grafico_bpm_atualizar(grafico_bpm_t *grafico, uint8_t *ssd);
+void grafico_bpm_redesenhar(grafico_bpm_t *grafico, uint8_t *ssd);
+
+#endif
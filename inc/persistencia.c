@@ -0,0 +1,79 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "persistencia.h"
+
+#define PERSISTENCIA_MAGICA 0x48575452u // "HWTR"
+
+typedef struct {
+    uint32_t magica;
+    uint32_t tamanho;
+    uint32_t crc;
+    uint32_t reservado;
+} cabecalho_t;
+
+// Buffer de gravação: a flash é programada em páginas de 256 bytes
+static uint8_t buffer_flash[(sizeof(cabecalho_t) + PERSISTENCIA_TAMANHO_MAX + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE];
+
+static uint32_t deslocamento_setor(int setor) {
+    return PICO_FLASH_SIZE_BYTES - (setor + 1) * FLASH_SECTOR_SIZE;
+}
+
+static uint32_t crc32(const uint8_t *dados, size_t tamanho) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < tamanho; i++) {
+        crc ^= dados[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+// Apaga o setor e grava o registro; as interrupções ficam desabilitadas durante a
+// operação, pois o código não pode executar da flash enquanto ela é escrita
+bool persistencia_salvar(int setor, const void *dados, size_t tamanho) {
+    if (setor < 0 || setor >= PERSISTENCIA_SETORES || tamanho > PERSISTENCIA_TAMANHO_MAX) {
+        return false;
+    }
+
+    cabecalho_t cabecalho = {
+        .magica = PERSISTENCIA_MAGICA,
+        .tamanho = tamanho,
+        .crc = crc32(dados, tamanho),
+        .reservado = 0
+    };
+    size_t total = (sizeof(cabecalho) + tamanho + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+
+    memset(buffer_flash, 0xFF, total);
+    memcpy(buffer_flash, &cabecalho, sizeof(cabecalho));
+    memcpy(buffer_flash + sizeof(cabecalho), dados, tamanho);
+
+    uint32_t status = save_and_disable_interrupts();
+    flash_range_erase(deslocamento_setor(setor), FLASH_SECTOR_SIZE);
+    flash_range_program(deslocamento_setor(setor), buffer_flash, total);
+    restore_interrupts(status);
+    return true;
+}
+
+// Retorna o tamanho do registro lido ou 0 se o setor não contém um registro válido
+size_t persistencia_carregar(int setor, void *dados, size_t tamanho_max) {
+    if (setor < 0 || setor >= PERSISTENCIA_SETORES) {
+        return 0;
+    }
+
+    const uint8_t *flash = (const uint8_t *)(XIP_BASE + deslocamento_setor(setor));
+    cabecalho_t cabecalho;
+    memcpy(&cabecalho, flash, sizeof(cabecalho));
+
+    if (cabecalho.magica != PERSISTENCIA_MAGICA || cabecalho.tamanho > tamanho_max) {
+        return 0;
+    }
+    if (crc32(flash + sizeof(cabecalho), cabecalho.tamanho) != cabecalho.crc) {
+        return 0;
+    }
+
+    memcpy(dados, flash + sizeof(cabecalho), cabecalho.tamanho);
+    return cabecalho.tamanho;
+}
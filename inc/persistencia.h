@@ -0,0 +1,17 @@
+#ifndef persistencia_inc_h
+#define persistencia_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Registros persistidos nos últimos setores da flash (um setor de 4 KB por registro),
+// com cabeçalho de validação (mágica, tamanho e CRC-32)
+#define PERSISTENCIA_SETOR_LEMBRETES 0
+#define PERSISTENCIA_SETORES 1
+#define PERSISTENCIA_TAMANHO_MAX 1024
+
+bool persistencia_salvar(int setor, const void *dados, size_t tamanho);
+size_t persistencia_carregar(int setor, void *dados, size_t tamanho_max);
+
+#endif
@@ -0,0 +1,53 @@
+#include "hardware/watchdog.h"
+#include "reinicio.h"
+
+#define REINICIO_MAGICA 0x48575253u // "HWRS"
+
+// Disposição nos registradores de rascunho:
+//   [0] mágica  [1] estado compactado  [2] ms desde a gravação  [3] verificação
+static uint32_t compactar(const estado_reinicio_t *estado) {
+    return (uint32_t)estado->alerta |
+           ((uint32_t)estado->lembrete_pendente << 8) |
+           ((uint32_t)estado->submenu_ativo << 9) |
+           ((uint32_t)estado->pagina_vfc << 10) |
+           ((uint32_t)estado->submenu_indice << 16) |
+           ((uint32_t)estado->menu_indice << 24);
+}
+
+// Chamada a cada volta do laço principal: são só quatro escritas em registradores
+void reinicio_salvar(const estado_reinicio_t *estado) {
+    uint32_t compactado = compactar(estado);
+    watchdog_hw->scratch[1] = compactado;
+    watchdog_hw->scratch[2] = estado->ms_desde_salvamento;
+    watchdog_hw->scratch[3] = REINICIO_MAGICA ^ compactado ^ estado->ms_desde_salvamento;
+    watchdog_hw->scratch[0] = REINICIO_MAGICA;
+}
+
+// Retorna true se o reset veio do estouro do watchdog e os registradores guardam um
+// estado válido (reinício a quente)
+bool reinicio_restaurar(estado_reinicio_t *estado) {
+    // watchdog_caused_reboot() também é verdadeiro após watchdog_reboot(); só o estouro
+    // do watchdog habilitado por watchdog_enable() indica um travamento
+    if (!watchdog_enable_caused_reboot()) {
+        return false;
+    }
+
+    uint32_t compactado = watchdog_hw->scratch[1];
+    uint32_t ms_desde_salvamento = watchdog_hw->scratch[2];
+    bool valido = watchdog_hw->scratch[0] == REINICIO_MAGICA &&
+                  watchdog_hw->scratch[3] == (REINICIO_MAGICA ^ compactado ^ ms_desde_salvamento);
+    if (!valido) {
+        return false;
+    }
+
+    estado->alerta = compactado & 0xFF;
+    estado->lembrete_pendente = (compactado >> 8) & 1;
+    estado->submenu_ativo = (compactado >> 9) & 1;
+    estado->pagina_vfc = (compactado >> 10) & 1;
+    estado->submenu_indice = (compactado >> 16) & 0xFF;
+    estado->menu_indice = (compactado >> 24) & 0xFF;
+    // Da última gravação nos rascunhos ao reset passou o tempo do watchdog
+    estado->ms_desde_salvamento = (ms_desde_salvamento > UINT32_MAX - REINICIO_WATCHDOG_MS)
+                                  ? UINT32_MAX : ms_desde_salvamento + REINICIO_WATCHDOG_MS;
+    return true;
+}
@@ -0,0 +1,36 @@
+#ifndef reinicio_inc_h
+#define reinicio_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Tempo sem watchdog_update() até o watchdog reiniciar o sistema. Cobre a operação mais
+// longa do laço principal (apagar e gravar um setor da flash, até ~400 ms)
+#define REINICIO_WATCHDOG_MS 2000
+
+// Estado preservado entre reinícios a quente nos registradores de rascunho 0-3 do
+// watchdog (o SDK usa os 4-7). Eles sobrevivem ao reset pelo watchdog, mas são zerados
+// ao ligar a alimentação ou em um brownout; nesse caso só a flash é restaurada. O estado
+// só é restaurado quando o reinício veio do estouro do watchdog (travamento): um
+// watchdog_reboot() (picotool, sessão de depuração) também preserva os rascunhos, mas
+// não deve trazer de volta um alerta ou tela antigos.
+typedef struct {
+    uint8_t alerta;                // enum TipoAlerta em exibição (SEM_ALERTA se nenhum)
+    bool lembrete_pendente;        // Lembrete vencido aguardando a tela de alerta
+    bool submenu_ativo;
+    uint8_t submenu_indice;
+    bool pagina_vfc;               // Monitoramento exibindo a página de VFC
+    uint8_t menu_indice;
+    uint32_t ms_desde_salvamento;  // Tempo desde a última gravação dos lembretes na flash
+} estado_reinicio_t;
+
+// Deve ser chamada logo após watchdog_update(): o reset por estouro acontece então
+// REINICIO_WATCHDOG_MS depois da última chamada
+void reinicio_salvar(const estado_reinicio_t *estado);
+// Retorna true e o estado em um reinício pelo estouro do watchdog; ms_desde_salvamento
+// passa a incluir o tempo da última chamada a reinicio_salvar() até o reset. Deve ser
+// chamada antes de watchdog_enable(), que regrava a mágica do SDK no rascunho 4 e
+// apagaria a distinção entre o estouro e um watchdog_reboot()
+bool reinicio_restaurar(estado_reinicio_t *estado);
+
+#endif
@@ -0,0 +1,119 @@
+#include "sinais.h"
+
+// Calcula o BPM instantâneo com base na leitura do ADC (eixo Y do joystick)
+uint8_t sinais_bpm_de_adc(uint16_t adc_y) {
+    if (adc_y < 1000) {
+        return (uint8_t)(adc_y * 0.04);
+    } else if (adc_y > 3000) {
+        float excesso = adc_y - 3000;
+        return 80 + (uint8_t)(excesso * 0.04);
+    } else {
+        return 50 + (uint8_t)((adc_y - 1000) * 0.015);
+    }
+}
+
+void sinais_media_init(media_bpm_t *media) {
+    media->indice = 0;
+    media->coletadas = 0;
+    media->media = BPM_INICIAL;
+    media->variancia = 0;
+}
+
+// Adiciona uma amostra que cobre os últimos duracao_ms e recalcula média e variância
+// sobre a janela, da amostra mais nova para a mais antiga (a última entra só com a
+// parte que cabe na janela)
+uint8_t sinais_media_adicionar(media_bpm_t *media, uint8_t amostra, uint32_t duracao_ms) {
+    if (duracao_ms > JANELA_MEDIA_MS) {
+        duracao_ms = JANELA_MEDIA_MS;
+    }
+    media->valores[media->indice] = amostra;
+    media->duracoes[media->indice] = duracao_ms;
+    media->indice = (media->indice + 1) % AMOSTRAS_BPM_MAX;
+    if (media->coletadas < AMOSTRAS_BPM_MAX) {
+        media->coletadas++;
+    }
+
+    uint32_t peso_total = 0, soma = 0, soma_quadrados = 0;
+    uint8_t i = media->indice;
+    for (uint8_t n = 0; n < media->coletadas && peso_total < JANELA_MEDIA_MS; n++) {
+        i = (i == 0) ? AMOSTRAS_BPM_MAX - 1 : i - 1;
+        uint32_t peso = media->duracoes[i];
+        if (peso > JANELA_MEDIA_MS - peso_total) {
+            peso = JANELA_MEDIA_MS - peso_total;
+        }
+        peso_total += peso;
+        soma += peso * media->valores[i];
+        soma_quadrados += peso * media->valores[i] * media->valores[i];
+    }
+
+    if (peso_total == 0) {
+        return media->media; // Amostras de duração nula não mudam a média
+    }
+    media->media = soma / peso_total;
+    // Var = E[x²] - E[x]², sem arredondar E[x] para não perder a parte fracionária
+    uint64_t diferenca = (uint64_t)soma_quadrados * peso_total - (uint64_t)soma * soma;
+    media->variancia = diferenca / ((uint64_t)peso_total * peso_total);
+    return media->media;
+}
+
+// Próximo intervalo de amostragem: o mínimo com a amostra fora da faixa normal
+// (MIN_BPM..MAX_BPM) ou com o sinal instável, subindo até o máximo conforme a média se
+// afasta dos limites da faixa
+uint32_t sinais_intervalo_amostragem_ms(const media_bpm_t *media, uint8_t amostra) {
+    if (amostra < MIN_BPM || amostra > MAX_BPM || media->media < MIN_BPM || media->media > MAX_BPM ||
+        media->variancia >= DESVIO_INSTAVEL_BPM * DESVIO_INSTAVEL_BPM) {
+        return INTERVALO_AMOSTRAGEM_MIN_MS;
+    }
+
+    uint32_t distancia = media->media - MIN_BPM;
+    if ((uint32_t)(MAX_BPM - media->media) < distancia) {
+        distancia = MAX_BPM - media->media;
+    }
+    if (distancia > MARGEM_ESTAVEL_BPM) {
+        distancia = MARGEM_ESTAVEL_BPM;
+    }
+
+    // Interpolação pela distância, encurtada conforme a variância se aproxima do limite
+    // de instabilidade (o ruído de ±1 BPM de um sinal estável quase não pesa)
+    const uint32_t variancia_instavel = DESVIO_INSTAVEL_BPM * DESVIO_INSTAVEL_BPM;
+    uint32_t intervalo = INTERVALO_AMOSTRAGEM_MIN_MS +
+                         (INTERVALO_AMOSTRAGEM_MAX_MS - INTERVALO_AMOSTRAGEM_MIN_MS) * distancia / MARGEM_ESTAVEL_BPM;
+    intervalo = intervalo * variancia_instavel / (variancia_instavel + media->variancia);
+    return intervalo < INTERVALO_AMOSTRAGEM_MIN_MS ? INTERVALO_AMOSTRAGEM_MIN_MS : intervalo;
+}
+
+void sinais_avaliador_init(avaliador_alertas_t *avaliador) {
+    avaliador->estado_critico = false;
+    avaliador->inicio_estado_critico_ms = 0;
+}
+
+// Avalia os alertas dos sensores com histerese; retorna SEM_ALERTA enquanto nada
+// deve ser disparado
+enum TipoAlerta sinais_avaliar_alertas(avaliador_alertas_t *avaliador, uint8_t media_bpm,
+                                       uint16_t adc_x, uint32_t tempo_ms) {
+    enum TipoAlerta alerta = SEM_ALERTA;
+
+    // Verifica se o BPM está fora dos limites críticos
+    bool bpm_critico = (media_bpm < CRIT_MIN_BPM || media_bpm > CRIT_MAX_BPM);
+
+    // Se não estava em estado crítico e agora está, registra o início
+    if (!avaliador->estado_critico && bpm_critico) {
+        avaliador->estado_critico = true;
+        avaliador->inicio_estado_critico_ms = tempo_ms;
+    }
+    // Se estava em estado crítico e não está mais, reseta o estado
+    else if (avaliador->estado_critico && !bpm_critico) {
+        avaliador->estado_critico = false;
+    }
+
+    // Se está em estado crítico e já passou o tempo de histerese, aciona o alarme
+    if (avaliador->estado_critico && (tempo_ms - avaliador->inicio_estado_critico_ms >= TEMPO_HISTERESE_MS)) {
+        alerta = (media_bpm < CRIT_MIN_BPM) ? BATIMENTO_BAIXO : BATIMENTO_ALTO;
+    }
+
+    // A queda tem prioridade sobre o alerta de batimento
+    if (adc_x < GIROSCOPIO_QUEDA_MIN || adc_x > GIROSCOPIO_QUEDA_MAX) {
+        alerta = QUEDA_DETECTADA;
+    }
+    return alerta;
+}
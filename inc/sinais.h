@@ -0,0 +1,73 @@
+#ifndef sinais_inc_h
+#define sinais_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Limites para alertas dos sensores
+#define MIN_BPM 50
+#define MAX_BPM 80
+#define CRIT_MIN_BPM 40
+#define CRIT_MAX_BPM 120
+#define GIROSCOPIO_QUEDA_MIN 500
+#define GIROSCOPIO_QUEDA_MAX 3500
+#define GIROSCOPIO_INCLINADO_MIN 1000
+#define GIROSCOPIO_INCLINADO_MAX 3000
+
+// Definições para o sistema de média móvel e histerese
+#define JANELA_MEDIA_MS 2000            // Duração da janela da média móvel
+#define TEMPO_HISTERESE_MS 2000         // Tempo mínimo em estado de alarme para acionar
+#define BPM_INICIAL 65                  // Média antes da primeira amostra
+
+// Amostragem adaptativa: lenta com o BPM estável e dentro da faixa normal, rápida
+// com o sinal variando ou perto dos limites
+#define INTERVALO_AMOSTRAGEM_MIN_MS 100
+#define INTERVALO_AMOSTRAGEM_MAX_MS 1000
+#define MARGEM_ESTAVEL_BPM 10           // Distância aos limites da faixa normal para o intervalo máximo
+#define DESVIO_INSTAVEL_BPM 4           // Desvio padrão na janela a partir do qual o intervalo é o mínimo
+
+// No pior caso (todas as amostras no intervalo mínimo) a janela cabe neste buffer
+#define AMOSTRAS_BPM_MAX (JANELA_MEDIA_MS / INTERVALO_AMOSTRAGEM_MIN_MS)
+
+// Tipo de alerta
+enum TipoAlerta {
+    SEM_ALERTA,
+    BATIMENTO_BAIXO,
+    BATIMENTO_ALTO,
+    QUEDA_DETECTADA,
+    ALARME_TEMPORIZADOR,
+    SOS_ALARME,
+    TENDENCIA_BPM        // Subida ou queda sustentada (inc/tendencia.h)
+};
+
+// Média móvel dos últimos JANELA_MEDIA_MS, ponderada pela duração de cada amostra
+// (o tempo desde a anterior), para que a janela seja a mesma com qualquer intervalo.
+// Com o intervalo fixo de 200 ms equivale à média simples das últimas 10 amostras.
+typedef struct {
+    uint8_t valores[AMOSTRAS_BPM_MAX];   // Buffer circular das amostras
+    uint16_t duracoes[AMOSTRAS_BPM_MAX]; // Tempo coberto por cada amostra (ms)
+    uint8_t indice;                      // Posição da próxima amostra
+    uint8_t coletadas;                   // Amostras válidas no buffer
+    uint8_t media;                       // Média atual de BPM
+    uint16_t variancia;                  // Variância na janela (BPM²)
+} media_bpm_t;
+
+// Estado da histerese do BPM crítico
+typedef struct {
+    bool estado_critico;                // Flag para indicar se está em estado crítico
+    uint32_t inicio_estado_critico_ms;  // Timestamp de quando o estado crítico começou
+} avaliador_alertas_t;
+
+// Processamento dos sinais separado do hardware (ADC, LED, buzzer), para que o mesmo
+// código rode no firmware e nos benchmarks de host
+uint8_t sinais_bpm_de_adc(uint16_t adc_y);
+
+void sinais_media_init(media_bpm_t *media);
+uint8_t sinais_media_adicionar(media_bpm_t *media, uint8_t amostra, uint32_t duracao_ms);
+uint32_t sinais_intervalo_amostragem_ms(const media_bpm_t *media, uint8_t amostra);
+
+void sinais_avaliador_init(avaliador_alertas_t *avaliador);
+enum TipoAlerta sinais_avaliar_alertas(avaliador_alertas_t *avaliador, uint8_t media_bpm,
+                                       uint16_t adc_x, uint32_t tempo_ms);
+
+#endif
@@ -1,9 +1,12 @@
 #include "ssd1306_i2c.h"
+extern uint32_t ssd1306_bytes_enviados;
 extern void calculate_render_area_buffer_length(struct render_area *area);
 extern void ssd1306_send_command(uint8_t cmd);
 extern void ssd1306_send_command_list(uint8_t *ssd, int number);
 extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
 extern void ssd1306_init();
+extern void ssd1306_set_contrast_level(uint8_t contrast);
+extern void ssd1306_display_on(bool on);
 extern void ssd1306_scroll(bool set);
 extern void render_on_display(uint8_t *ssd, struct render_area *area);
 extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
@@ -1,4 +1,4 @@
-static uint8_t font[] = {
+static const uint8_t font[] = {
     // Nothing
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
@@ -7,39 +7,54 @@
 #include "hardware/i2c.h"
 #include "ssd1306_font.h"
 #include "ssd1306_i2c.h"
+#include "display.h"
+#include "trace.h"
+#include "espelho.h"
+#if ESPELHO_ENABLED
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#endif
+
+// Total de bytes enviados ao barramento (contabilizado pelo backend em display_*.c)
+uint32_t ssd1306_bytes_enviados = 0;
 
 // Calcular quanto do buffer será destinado à área de renderização
 void calculate_render_area_buffer_length(struct render_area *area) {
     area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
 }
 
-// Processo de escrita do i2c espera um byte de controle, seguido por dados
+// Envia um único comando ao display pelo backend selecionado
 void ssd1306_send_command(uint8_t command) {
-    uint8_t buffer[2] = {0x80, command};
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
+    display_bus_write_commands(&command, 1);
 }
 
-// Envia uma lista de comandos ao hardware
+// Envia uma lista de comandos ao hardware (em uma única transação do barramento)
 void ssd1306_send_command_list(uint8_t *ssd, int number) {
-    for (int i = 0; i < number; i++) {
-        ssd1306_send_command(ssd[i]);
-    }
+    display_bus_write_commands(ssd, number);
 }
 
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
+// Envia dados à GRAM; o byte de controle (I2C) ou o pino D/C (SPI) ficam a cargo do backend
 void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
-
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
-
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
-
-    free(temp_buffer);
+    display_bus_write_data(ssd, buffer_length);
 }
 
 // Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
 void ssd1306_init() {
+    display_bus_init();
+
+#if DISPLAY_CONTROLLER_SH1106
+    // O SH1106 não tem modo de endereçamento nem o comando 0x8D: usa o conversor DC-DC (0xAD)
+    uint8_t commands[] = {
+        ssd1306_set_display, ssd1306_set_display_start_line,
+        ssd1306_set_segment_remap | 0x01, ssd1306_set_mux_ratio, ssd1306_height - 1,
+        ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset, 0x00,
+        ssd1306_set_common_pin_configuration, 0x12,
+        ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge, 0x22,
+        ssd1306_set_vcomh_deselect_level, 0x35, ssd1306_set_contrast, 0xFF,
+        ssd1306_set_entire_on, ssd1306_set_normal_display,
+        sh1106_set_dc_dc, 0x8B, ssd1306_set_display | 0x01,
+    };
+#else
     uint8_t commands[] = {
         ssd1306_set_display, ssd1306_set_memory_mode, 0x00,
         ssd1306_set_display_start_line, ssd1306_set_segment_remap | 0x01, 
@@ -60,22 +75,115 @@ void ssd1306_init() {
         ssd1306_set_charge_pump, 0x14, ssd1306_set_scroll | 0x00,
         ssd1306_set_display | 0x01,
     };
+#endif
+
+    ssd1306_send_command_list(commands, count_of(commands));
+}
+
+// Ajusta o contraste (brilho) do painel
+void ssd1306_set_contrast_level(uint8_t contrast) {
+    uint8_t commands[] = {ssd1306_set_contrast, contrast};
 
     ssd1306_send_command_list(commands, count_of(commands));
 }
 
+// Liga ou desliga o painel; o conteúdo da GRAM é preservado enquanto desligado
+void ssd1306_display_on(bool on) {
+    ssd1306_send_command(ssd1306_set_display | (on ? 0x01 : 0x00));
+}
+
 // Cria a lista de comandos para configurar o scrolling
 void ssd1306_scroll(bool set) {
+#if DISPLAY_CONTROLLER_SH1106
+    (void)set; // O SH1106 não possui rolagem por hardware
+#else
     uint8_t commands[] = {
         ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
         0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)
     };
 
     ssd1306_send_command_list(commands, count_of(commands));
+#endif
+}
+
+#if ESPELHO_ENABLED
+// Espelhamento pelo stdio: cada área enviada ao display gera um pacote com a diferença.
+// O pacote vai direto ao FIFO de transmissão do CDC (256 bytes), só com o que cabe nele:
+// um quadro-chave de até ~1 KB sai em partes e, se o host abriu a porta mas não lê, o
+// render espera no máximo ESPELHO_ESPERA_US em vez do timeout do stdio_usb por bloco
+// (que derrubaria o watchdog). Enquanto um pacote não sai inteiro as áreas seguintes
+// são puladas e o próximo pacote é um quadro-chave.
+#define ESPELHO_ESPERA_US 5000
+
+static espelho_t espelho = {.desde_chave = ESPELHO_CHAVE_A_CADA};
+static uint8_t espelho_pacote[ESPELHO_PACOTE_MAX];
+static uint16_t espelho_tamanho = 0;  // Bytes do pacote em envio
+static uint16_t espelho_enviados = 0; // Bytes já entregues ao FIFO
+
+// Entrega ao FIFO o restante do pacote até o prazo; true se ele saiu inteiro
+static bool espelho_escoar(uint64_t prazo_us) {
+    while (espelho_enviados < espelho_tamanho) {
+        uint32_t livre = tud_cdc_write_available();
+        if (livre == 0) {
+            // A tarefa do USB roda na interrupção do stdio_usb e esvazia o FIFO
+            if (time_us_64() >= prazo_us) {
+                return false;
+            }
+            continue;
+        }
+        uint16_t n = espelho_tamanho - espelho_enviados;
+        if (n > livre) {
+            n = livre;
+        }
+        stdio_usb.out_chars((const char *)&espelho_pacote[espelho_enviados], n);
+        espelho_enviados += n;
+    }
+    return true;
+}
+
+static void espelhar(const uint8_t *ssd, const struct render_area *area) {
+    // Sem terminal aberto o pacote em curso é descartado (o leitor descarta um pacote
+    // incompleto pelo checksum) e quem abrir a porta recebe um quadro-chave
+    if (!stdio_usb_connected()) {
+        espelho_tamanho = espelho_enviados = 0;
+        espelho_pular(&espelho, ssd, area);
+        return;
+    }
+
+    uint64_t prazo_us = time_us_64() + ESPELHO_ESPERA_US;
+    if (!espelho_escoar(prazo_us)) {
+        espelho_pular(&espelho, ssd, area);
+        return;
+    }
+    espelho_tamanho = espelho_codificar(&espelho, ssd, area, espelho_pacote);
+    espelho_enviados = 0;
+    espelho_escoar(prazo_us);
 }
+#endif
 
 // Atualiza uma parte do display com uma área de renderização
 void render_on_display(uint8_t *ssd, struct render_area *area) {
+    TRACE_BEGIN(TRACE_RENDER_ON_DISPLAY);
+#if ESPELHO_ENABLED
+    espelhar(ssd, area);
+#endif
+#if DISPLAY_CONTROLLER_SH1106
+    // Sem endereçamento horizontal no SH1106: posiciona e envia página a página
+    int width = area->end_column - area->start_column + 1;
+    uint8_t column = area->start_column + DISPLAY_COLUMN_OFFSET;
+
+    for (int page = area->start_page; page <= area->end_page; page++) {
+        uint8_t commands[] = {
+            sh1106_set_page_address | page,
+            sh1106_set_low_column | (column & 0x0F),
+            sh1106_set_high_column | (column >> 4)
+        };
+
+        ssd1306_send_command_list(commands, count_of(commands));
+        ssd1306_send_buffer(ssd, width);
+        ssd += width;
+    }
+#else
     uint8_t commands[] = {
         ssd1306_set_column_address, area->start_column, area->end_column,
         ssd1306_set_page_address, area->start_page, area->end_page
@@ -83,6 +191,8 @@ void render_on_display(uint8_t *ssd, struct render_area *area) {
 
     ssd1306_send_command_list(commands, count_of(commands));
     ssd1306_send_buffer(ssd, area->buffer_length);
+#endif
+    TRACE_END(TRACE_RENDER_ON_DISPLAY);
 }
 
 // Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
@@ -178,48 +288,30 @@ void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
 }
 
 // Comando de configuração com base na estrutura ssd1306_t
+// (a API baseada em ssd1306_t usa o mesmo backend da API com render_area)
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-	ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false );
+    (void)ssd;
+    ssd1306_send_command(command);
 }
 
-// Função de configuração do display para o caso do bitmap
+// Função de configuração do display para o caso do bitmap (endereçamento vertical)
 void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_display | 0x00);
+    ssd1306_init();
+#if !DISPLAY_CONTROLLER_SH1106
     ssd1306_command(ssd, ssd1306_set_memory_mode);
     ssd1306_command(ssd, 0x01);
-    ssd1306_command(ssd, ssd1306_set_display_start_line | 0x00);
-    ssd1306_command(ssd, ssd1306_set_segment_remap | 0x01);
-    ssd1306_command(ssd, ssd1306_set_mux_ratio);
-    ssd1306_command(ssd, ssd1306_height - 1);
-    ssd1306_command(ssd, ssd1306_set_common_output_direction | 0x08);
-    ssd1306_command(ssd, ssd1306_set_display_offset);
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, ssd1306_set_common_pin_configuration);
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, ssd1306_set_display_clock_divide_ratio);
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, ssd1306_set_precharge);
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, ssd1306_set_vcomh_deselect_level);
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, ssd1306_set_contrast);
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, ssd1306_set_entire_on);
-    ssd1306_command(ssd, ssd1306_set_normal_display);
-    ssd1306_command(ssd, ssd1306_set_charge_pump);
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, ssd1306_set_display | 0x01);
+#endif
 }
 
 // Inicializa o display para o caso de exibição de bitmap
+// (address e i2c são mantidos na estrutura por compatibilidade; o barramento vem do backend)
 void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
     ssd->width = width;
     ssd->height = height;
     ssd->pages = height / 8U;
     ssd->address = address;
     ssd->i2c_port = i2c;
+    ssd->external_vcc = external_vcc;
     ssd->bufsize = ssd->pages * ssd->width + 1;
     ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
     ssd->ram_buffer[0] = 0x40;
@@ -228,21 +320,18 @@ void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool externa
 
 // Envia os dados ao display
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_column_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, ssd1306_set_page_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
-    ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false );
+    struct render_area area = {
+        .start_column = 0,
+        .end_column = ssd->width - 1,
+        .start_page = 0,
+        .end_page = ssd->pages - 1
+    };
+    calculate_render_area_buffer_length(&area);
+    render_on_display(ssd->ram_buffer + 1, &area);
 }
 
 // Desenha o bitmap (a ser fornecido em display_oled.c) no display
 void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
-    for (int i = 0; i < ssd->bufsize - 1; i++) {
-        ssd->ram_buffer[i + 1] = bitmap[i];
-
-        ssd1306_send_data(ssd);
-    }
+    memcpy(ssd->ram_buffer + 1, bitmap, ssd->bufsize - 1);
+    ssd1306_send_data(ssd);
 }
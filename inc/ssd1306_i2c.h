@@ -40,6 +40,12 @@
 #define ssd1306_set_common_pin_configuration _u(0xDA)
 #define ssd1306_set_vcomh_deselect_level _u(0xDB)
 
+// Comandos exclusivos do SH1106 (sem endereçamento horizontal)
+#define sh1106_set_low_column _u(0x00)
+#define sh1106_set_high_column _u(0x10)
+#define sh1106_set_dc_dc _u(0xAD)
+#define sh1106_set_page_address _u(0xB0)
+
 #define ssd1306_page_height _u(8)
 #define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
 #define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
@@ -0,0 +1,163 @@
+#include <string.h>
+#include "telemetria.h"
+
+static void escrever_u16(uint8_t *p, uint16_t valor) {
+    p[0] = valor & 0xFF;
+    p[1] = valor >> 8;
+}
+
+static void escrever_u32(uint8_t *p, uint32_t valor) {
+    escrever_u16(p, valor & 0xFFFF);
+    escrever_u16(p + 2, valor >> 16);
+}
+
+void telemetria_init(telemetria_t *telemetria) {
+    memset(telemetria, 0, sizeof(*telemetria));
+    telemetria->espera_ms = TELEMETRIA_ESPERA_MIN_MS;
+    telemetria->transporte_iniciado = telemetria_transporte_init();
+}
+
+// Retira da fila o lote mais antigo sem alertas (ou o mais antigo, se todos tiverem),
+// deslocando os seguintes para manter a ordem de envio
+static void descartar_lote(telemetria_t *telemetria) {
+    uint8_t vitima = 0;
+    while (vitima < telemetria->quantidade &&
+           telemetria->fila[(telemetria->inicio + vitima) % TELEMETRIA_FILA_LOTES].alertas > 0) {
+        vitima++;
+    }
+    if (vitima == telemetria->quantidade) {
+        vitima = 0;
+    }
+    telemetria->estatisticas.lotes_descartados++;
+    telemetria->estatisticas.alertas_descartados += telemetria->fila[(telemetria->inicio + vitima) % TELEMETRIA_FILA_LOTES].alertas;
+
+    for (uint8_t i = vitima; i > 0; i--) {
+        memcpy(&telemetria->fila[(telemetria->inicio + i) % TELEMETRIA_FILA_LOTES],
+               &telemetria->fila[(telemetria->inicio + i - 1) % TELEMETRIA_FILA_LOTES], sizeof(telemetria_lote_t));
+    }
+    telemetria->inicio = (telemetria->inicio + 1) % TELEMETRIA_FILA_LOTES;
+    telemetria->quantidade--;
+}
+
+// Move o lote aberto para o fim da fila; com a fila cheia um lote é descartado
+static void fechar_lote(telemetria_t *telemetria) {
+    telemetria_lote_t *aberto = &telemetria->aberto;
+    if (aberto->tamanho == 0) {
+        return;
+    }
+
+    aberto->dados[0] = TELEMETRIA_MAGICA;
+    aberto->dados[1] = (aberto->tamanho - TELEMETRIA_CABECALHO_BYTES) / TELEMETRIA_REGISTRO_BYTES;
+    escrever_u16(&aberto->dados[2], telemetria->sequencia++);
+    escrever_u32(&aberto->dados[4], aberto->criado_ms);
+
+    if (telemetria->quantidade == TELEMETRIA_FILA_LOTES) {
+        descartar_lote(telemetria);
+    }
+    uint8_t fim = (telemetria->inicio + telemetria->quantidade) % TELEMETRIA_FILA_LOTES;
+    memcpy(&telemetria->fila[fim], aberto, sizeof(*aberto));
+    telemetria->quantidade++;
+    aberto->tamanho = 0;
+    aberto->alertas = 0;
+}
+
+static void registrar(telemetria_t *telemetria, uint32_t agora_ms, uint8_t tipo, uint8_t v0, uint16_t v1) {
+    telemetria_lote_t *aberto = &telemetria->aberto;
+
+    // O intervalo até o registro anterior precisa caber em 16 bits
+    if (aberto->tamanho > 0 && agora_ms - telemetria->ultimo_registro_ms > UINT16_MAX) {
+        fechar_lote(telemetria);
+    }
+    if (aberto->tamanho == 0) {
+        aberto->tamanho = TELEMETRIA_CABECALHO_BYTES;
+        aberto->criado_ms = agora_ms;
+        telemetria->ultimo_registro_ms = agora_ms;
+    }
+
+    uint8_t *registro = &aberto->dados[aberto->tamanho];
+    registro[0] = tipo;
+    escrever_u16(&registro[1], agora_ms - telemetria->ultimo_registro_ms);
+    registro[3] = v0;
+    escrever_u16(&registro[4], v1);
+    aberto->tamanho += TELEMETRIA_REGISTRO_BYTES;
+    aberto->alertas += (tipo == TELEMETRIA_ALERTA);
+    telemetria->ultimo_registro_ms = agora_ms;
+    telemetria->estatisticas.registros++;
+
+    if (aberto->tamanho == TELEMETRIA_LOTE_MAX_BYTES) {
+        fechar_lote(telemetria);
+    }
+}
+
+void telemetria_registrar_sinais(telemetria_t *telemetria, uint32_t agora_ms, uint8_t media_bpm, uint16_t adc_x) {
+    // Contrapressão: com a fila perto do limite a resolução dos sinais é reduzida antes
+    // de qualquer lote ser descartado
+    if (telemetria->quantidade >= TELEMETRIA_FILA_ALTA) {
+        if (telemetria->contador_decimacao++ % TELEMETRIA_DECIMACAO != 0) {
+            telemetria->estatisticas.sinais_decimados++;
+            return;
+        }
+    } else {
+        telemetria->contador_decimacao = 0;
+    }
+    registrar(telemetria, agora_ms, TELEMETRIA_SINAIS, media_bpm, adc_x);
+}
+
+void telemetria_registrar_alerta(telemetria_t *telemetria, uint32_t agora_ms, uint8_t alerta, uint8_t media_bpm) {
+    registrar(telemetria, agora_ms, TELEMETRIA_ALERTA, alerta, media_bpm);
+    // Com a fila perto do limite o enlace está fora: o alerta segue no lote aberto em vez
+    // de ocupar sozinho uma posição da fila
+    if (telemetria->quantidade < TELEMETRIA_FILA_ALTA) {
+        fechar_lote(telemetria);
+    }
+}
+
+static void adiar(telemetria_t *telemetria, uint32_t agora_ms) {
+    telemetria->proxima_tentativa_ms = agora_ms + telemetria->espera_ms;
+    telemetria->espera_ms *= 2;
+    if (telemetria->espera_ms > TELEMETRIA_ESPERA_MAX_MS) {
+        telemetria->espera_ms = TELEMETRIA_ESPERA_MAX_MS;
+    }
+}
+
+void telemetria_processar(telemetria_t *telemetria, uint32_t agora_ms) {
+    // Com lotes já esperando na fila o aberto continua enchendo: fechá-lo por idade não
+    // adiantaria o envio e gastaria uma posição da fila durante uma queda do enlace
+    if (telemetria->aberto.tamanho > 0 && telemetria->quantidade == 0 &&
+        agora_ms - telemetria->aberto.criado_ms >= TELEMETRIA_LOTE_MS) {
+        fechar_lote(telemetria);
+    }
+    if (!telemetria->transporte_iniciado) {
+        return;
+    }
+
+    telemetria_transporte_processar();
+    if (telemetria->quantidade == 0 || (int32_t)(agora_ms - telemetria->proxima_tentativa_ms) < 0) {
+        return;
+    }
+    if (!telemetria_transporte_pronto()) {
+        adiar(telemetria, agora_ms);
+        return;
+    }
+
+    telemetria_lote_t *lote = &telemetria->fila[telemetria->inicio];
+    if (!telemetria_transporte_enviar(lote->dados, lote->tamanho)) {
+        telemetria->estatisticas.envios_recusados++;
+        adiar(telemetria, agora_ms);
+        return;
+    }
+
+    telemetria_estatisticas_t *estatisticas = &telemetria->estatisticas;
+    estatisticas->lotes_enviados++;
+    estatisticas->bytes_enviados += lote->tamanho;
+    if (agora_ms - lote->criado_ms > estatisticas->latencia_max_ms) {
+        estatisticas->latencia_max_ms = agora_ms - lote->criado_ms;
+    }
+    telemetria->inicio = (telemetria->inicio + 1) % TELEMETRIA_FILA_LOTES;
+    telemetria->quantidade--;
+    telemetria->espera_ms = TELEMETRIA_ESPERA_MIN_MS;
+}
+
+bool telemetria_pendente(const telemetria_t *telemetria) {
+    return telemetria->quantidade > 0 || telemetria->aberto.tamanho > 0;
+}
@@ -0,0 +1,96 @@
+#ifndef telemetria_inc_h
+#define telemetria_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Telemetria: sinais vitais e alertas agrupados em lotes binários compactos e enviados
+// por um transporte não bloqueante (UDP via lwIP no Pico W, socket UDP no host). Com
+// TELEMETRIA_ENABLED = 0 (padrão) nada é compilado no firmware; ativada pela opção
+// TELEMETRIA do CMake.
+#ifndef TELEMETRIA_ENABLED
+#define TELEMETRIA_ENABLED 0
+#endif
+
+// Formato de um lote (little-endian), cabe em um datagrama sem fragmentação:
+//   cabeçalho (8 bytes): [0] TELEMETRIA_MAGICA  [1] registros  [2-3] sequência
+//                        [4-7] instante do primeiro registro (ms desde o boot)
+//   registro (6 bytes):  [0] tipo  [1-2] ms desde o registro anterior  [3] v0  [4-5] v1
+//     TELEMETRIA_SINAIS: v0 = média de BPM, v1 = ADC do giroscópio
+//     TELEMETRIA_ALERTA: v0 = enum TipoAlerta (SEM_ALERTA: alerta encerrado), v1 = média de BPM
+#define TELEMETRIA_MAGICA 0x54 // 'T'
+#define TELEMETRIA_CABECALHO_BYTES 8
+#define TELEMETRIA_REGISTRO_BYTES 6
+#define TELEMETRIA_REGISTROS_POR_LOTE 32
+#define TELEMETRIA_LOTE_MAX_BYTES (TELEMETRIA_CABECALHO_BYTES + TELEMETRIA_REGISTROS_POR_LOTE * TELEMETRIA_REGISTRO_BYTES)
+
+#define TELEMETRIA_SINAIS 1
+#define TELEMETRIA_ALERTA 2
+
+// Um lote é fechado quando enche, logo após um alerta (que não espera o lote encher,
+// exceto com a fila acima de TELEMETRIA_FILA_ALTA) ou, com a fila vazia, quando o
+// primeiro registro completa TELEMETRIA_LOTE_MS
+#define TELEMETRIA_LOTE_MS 10000
+
+// Fila de lotes fechados enquanto o enlace está fora (16 x 200 bytes). Acima da marca
+// de TELEMETRIA_FILA_ALTA lotes só 1 a cada TELEMETRIA_DECIMACAO registros de sinais é
+// mantido; com a fila cheia o lote mais antigo sem alertas é descartado. Alertas nunca
+// são decimados e só se perdem se todos os lotes da fila tiverem algum alerta.
+#define TELEMETRIA_FILA_LOTES 16
+#define TELEMETRIA_FILA_ALTA 12
+#define TELEMETRIA_DECIMACAO 8
+
+// Espera entre tentativas quando o enlace não está pronto ou o envio é recusado
+// (contrapressão do transporte), dobrada a cada falha
+#define TELEMETRIA_ESPERA_MIN_MS 100
+#define TELEMETRIA_ESPERA_MAX_MS 10000
+
+typedef struct {
+    uint8_t dados[TELEMETRIA_LOTE_MAX_BYTES];
+    uint16_t tamanho;
+    uint8_t alertas;      // Registros TELEMETRIA_ALERTA no lote
+    uint32_t criado_ms;   // Instante do primeiro registro
+} telemetria_lote_t;
+
+typedef struct {
+    uint32_t registros;           // Registros aceitos
+    uint32_t sinais_decimados;    // Registros de sinais descartados pela decimação
+    uint32_t lotes_enviados;
+    uint32_t lotes_descartados;   // Lotes perdidos com a fila cheia
+    uint32_t alertas_descartados; // Alertas nesses lotes (fila cheia só de lotes com alertas)
+    uint32_t bytes_enviados;
+    uint32_t envios_recusados;    // Envios recusados pelo transporte
+    uint32_t latencia_max_ms;     // Maior espera de um lote (do primeiro registro ao envio)
+} telemetria_estatisticas_t;
+
+typedef struct {
+    telemetria_lote_t fila[TELEMETRIA_FILA_LOTES]; // Anel de lotes fechados
+    uint8_t inicio;
+    uint8_t quantidade;
+    telemetria_lote_t aberto;                      // Lote em preenchimento
+    uint32_t ultimo_registro_ms;
+    uint16_t sequencia;
+    uint8_t contador_decimacao;
+    bool transporte_iniciado;
+    uint32_t proxima_tentativa_ms;
+    uint32_t espera_ms;
+    telemetria_estatisticas_t estatisticas;
+} telemetria_t;
+
+void telemetria_init(telemetria_t *telemetria);
+// Registro O(1) sem E/S, seguro no caminho de amostragem
+void telemetria_registrar_sinais(telemetria_t *telemetria, uint32_t agora_ms, uint8_t media_bpm, uint16_t adc_x);
+void telemetria_registrar_alerta(telemetria_t *telemetria, uint32_t agora_ms, uint8_t alerta, uint8_t media_bpm);
+// Chamada a cada volta do laço principal: fecha lotes vencidos e envia no máximo um lote
+void telemetria_processar(telemetria_t *telemetria, uint32_t agora_ms);
+// Há registros aguardando envio
+bool telemetria_pendente(const telemetria_t *telemetria);
+
+// Interface implementada pelo transporte (inc/telemetria_lwip.c ou host/telemetria_udp.c)
+bool telemetria_transporte_init(void);
+void telemetria_transporte_processar(void);
+bool telemetria_transporte_pronto(void);
+// Não bloqueia: false se o transporte não aceitou o lote agora (sem memória, fila cheia)
+bool telemetria_transporte_enviar(const uint8_t *dados, uint16_t tamanho);
+
+#endif
@@ -0,0 +1,64 @@
+#include <string.h>
+#include "pico/cyw43_arch.h"
+#include "lwip/pbuf.h"
+#include "lwip/udp.h"
+#include "lwip/ip_addr.h"
+#include "telemetria.h"
+
+// Transporte da telemetria no Pico W: UDP via lwIP com o driver CYW43 em modo de
+// varredura (pico_cyw43_arch_lwip_poll). Tudo roda no laço principal, sem threads nem
+// interrupções do lwIP; a conexão ao Wi-Fi é assíncrona e refeita quando o enlace cai.
+// SSID, senha, destino e porta vêm do CMake (TELEMETRIA_WIFI_SSID etc.).
+
+static struct udp_pcb *pcb;
+static ip_addr_t destino;
+
+static void conectar(void) {
+    cyw43_arch_wifi_connect_async(TELEMETRIA_WIFI_SSID, TELEMETRIA_WIFI_SENHA, CYW43_AUTH_WPA2_AES_PSK);
+}
+
+bool telemetria_transporte_init(void) {
+    if (cyw43_arch_init() != 0) {
+        return false;
+    }
+    cyw43_arch_enable_sta_mode();
+    if (!ipaddr_aton(TELEMETRIA_DESTINO, &destino)) {
+        return false;
+    }
+    pcb = udp_new();
+    if (pcb == NULL) {
+        return false;
+    }
+    conectar();
+    return true;
+}
+
+// Processa os eventos pendentes do CYW43 e do lwIP (tempo limitado, não bloqueia)
+void telemetria_transporte_processar(void) {
+    cyw43_arch_poll();
+}
+
+bool telemetria_transporte_pronto(void) {
+    int estado = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+    if (estado == CYW43_LINK_UP) {
+        return true;
+    }
+    // Falha definitiva da tentativa anterior: inicia outra (o núcleo espaça as chamadas)
+    if (estado == CYW43_LINK_FAIL || estado == CYW43_LINK_NONET || estado == CYW43_LINK_BADAUTH ||
+        estado == CYW43_LINK_DOWN) {
+        conectar();
+    }
+    return false;
+}
+
+bool telemetria_transporte_enviar(const uint8_t *dados, uint16_t tamanho) {
+    // Sem memória no lwIP o lote fica na fila: contrapressão para o núcleo
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, tamanho, PBUF_RAM);
+    if (p == NULL) {
+        return false;
+    }
+    memcpy(p->payload, dados, tamanho);
+    err_t erro = udp_sendto(pcb, p, &destino, TELEMETRIA_PORTA);
+    pbuf_free(p);
+    return erro == ERR_OK;
+}
@@ -0,0 +1,242 @@
+#include <string.h>
+#include "temporizadores.h"
+
+#define MASCARA_POSICAO (TEMPORIZADORES_POSICOES - 1)
+#define TICKS_MAXIMO ((uint64_t)1 << (TEMPORIZADORES_NIVEIS * TEMPORIZADORES_BITS_NIVEL))
+
+// Tick em que o temporizador vence (arredondado para cima: nunca dispara antes do prazo)
+static uint64_t tick_do_prazo(uint64_t prazo_ms) {
+    return (prazo_ms + TEMPORIZADORES_TICK_MS - 1) / TEMPORIZADORES_TICK_MS;
+}
+
+// Remove o temporizador da lista da posição em que está
+static void desencadear(roda_temporizadores_t *roda, uint16_t id) {
+    temporizador_t *t = &roda->temporizadores[id];
+
+    if (t->anterior != TEMPORIZADOR_NENHUM) {
+        roda->temporizadores[t->anterior].proximo = t->proximo;
+    } else {
+        roda->listas[t->lista] = t->proximo;
+    }
+    if (t->proximo != TEMPORIZADOR_NENHUM) {
+        roda->temporizadores[t->proximo].anterior = t->anterior;
+    }
+}
+
+// Coloca o temporizador no nível adequado à distância até o prazo. Prazos anteriores
+// a tick_minimo vão para tick_minimo: o próximo tick em inserções normais, ou o tick
+// atual durante a cascata (cuja posição do nível 0 ainda será processada).
+static void encadear(roda_temporizadores_t *roda, uint16_t id, uint64_t tick_minimo) {
+    temporizador_t *t = &roda->temporizadores[id];
+    uint64_t tick = tick_do_prazo(t->prazo_ms);
+
+    if (tick < tick_minimo) {
+        tick = tick_minimo;
+    }
+    uint64_t distancia = tick - roda->tick_atual;
+    if (distancia >= TICKS_MAXIMO) {
+        tick = roda->tick_atual + TICKS_MAXIMO - 1;
+        distancia = TICKS_MAXIMO - 1;
+    }
+
+    int nivel = 0;
+    while (nivel < TEMPORIZADORES_NIVEIS - 1 && distancia >= ((uint64_t)1 << ((nivel + 1) * TEMPORIZADORES_BITS_NIVEL))) {
+        nivel++;
+    }
+    int posicao = (tick >> (nivel * TEMPORIZADORES_BITS_NIVEL)) & MASCARA_POSICAO;
+
+    t->lista = nivel * TEMPORIZADORES_POSICOES + posicao;
+    t->anterior = TEMPORIZADOR_NENHUM;
+    t->proximo = roda->listas[t->lista];
+    if (t->proximo != TEMPORIZADOR_NENHUM) {
+        roda->temporizadores[t->proximo].anterior = id;
+    }
+    roda->listas[t->lista] = id;
+}
+
+// Move todos os temporizadores de uma posição de nível superior para os níveis abaixo
+static void cascatear(roda_temporizadores_t *roda, int nivel, int posicao) {
+    uint16_t *lista = &roda->listas[nivel * TEMPORIZADORES_POSICOES + posicao];
+    uint16_t id = *lista;
+    *lista = TEMPORIZADOR_NENHUM;
+
+    while (id != TEMPORIZADOR_NENHUM) {
+        uint16_t proximo = roda->temporizadores[id].proximo;
+        encadear(roda, id, roda->tick_atual);
+        id = proximo;
+    }
+}
+
+void temporizadores_init(roda_temporizadores_t *roda, uint64_t agora_ms) {
+    memset(roda, 0, sizeof(*roda));
+    for (int i = 0; i < TEMPORIZADORES_NIVEIS * TEMPORIZADORES_POSICOES; i++) {
+        roda->listas[i] = TEMPORIZADOR_NENHUM;
+    }
+    for (int i = 0; i < TEMPORIZADORES_MAX; i++) {
+        roda->temporizadores[i].proximo = (i + 1 < TEMPORIZADORES_MAX) ? i + 1 : TEMPORIZADOR_NENHUM;
+    }
+    roda->livres = 0;
+    roda->tick_atual = agora_ms / TEMPORIZADORES_TICK_MS;
+}
+
+// Retorna o identificador do temporizador ou -1 se não houver espaço
+int temporizadores_adicionar(roda_temporizadores_t *roda, uint64_t prazo_ms, uint32_t periodo_ms) {
+    uint16_t id = roda->livres;
+    if (id == TEMPORIZADOR_NENHUM) {
+        return -1;
+    }
+
+    temporizador_t *t = &roda->temporizadores[id];
+    roda->livres = t->proximo;
+    t->prazo_ms = prazo_ms;
+    t->periodo_ms = periodo_ms;
+    t->ativo = true;
+    encadear(roda, id, roda->tick_atual + 1);
+    roda->quantidade++;
+    return id;
+}
+
+bool temporizadores_cancelar(roda_temporizadores_t *roda, int id) {
+    if (id < 0 || id >= TEMPORIZADORES_MAX || !roda->temporizadores[id].ativo) {
+        return false;
+    }
+
+    temporizador_t *t = &roda->temporizadores[id];
+    desencadear(roda, id);
+    t->ativo = false;
+    t->proximo = roda->livres;
+    roda->livres = id;
+    roda->quantidade--;
+    return true;
+}
+
+// Avança a roda até agora_ms, devolvendo os temporizadores que venceram. Os periódicos
+// são reagendados automaticamente; os demais são liberados.
+int temporizadores_avancar(roda_temporizadores_t *roda, uint64_t agora_ms, uint16_t *expirados, int max_expirados) {
+    uint64_t tick_alvo = agora_ms / TEMPORIZADORES_TICK_MS;
+    int total = 0;
+
+    while (roda->tick_atual < tick_alvo) {
+        // Roda vazia: salta direto para o tick alvo
+        if (roda->quantidade == 0) {
+            roda->tick_atual = tick_alvo;
+            break;
+        }
+        roda->tick_atual++;
+
+        // Quando os bits de um nível zeram, a posição correspondente do nível acima desce
+        for (int nivel = 1; nivel < TEMPORIZADORES_NIVEIS; nivel++) {
+            if (roda->tick_atual & (((uint64_t)1 << (nivel * TEMPORIZADORES_BITS_NIVEL)) - 1)) {
+                break;
+            }
+            cascatear(roda, nivel, (roda->tick_atual >> (nivel * TEMPORIZADORES_BITS_NIVEL)) & MASCARA_POSICAO);
+        }
+
+        // A lista é destacada antes de processar, pois periódicos podem ser reinseridos
+        uint16_t *lista = &roda->listas[roda->tick_atual & MASCARA_POSICAO];
+        uint16_t id = *lista;
+        *lista = TEMPORIZADOR_NENHUM;
+
+        while (id != TEMPORIZADOR_NENHUM) {
+            temporizador_t *t = &roda->temporizadores[id];
+            uint16_t proximo = t->proximo;
+
+            // Prazo além do alcance da roda: ainda não venceu, apenas reinsere
+            if (tick_do_prazo(t->prazo_ms) > roda->tick_atual) {
+                encadear(roda, id, roda->tick_atual + 1);
+                id = proximo;
+                continue;
+            }
+
+            if (total < max_expirados) {
+                expirados[total] = id;
+            }
+            total++;
+
+            if (t->periodo_ms > 0) {
+                t->prazo_ms += t->periodo_ms;
+                encadear(roda, id, roda->tick_atual + 1);
+            } else {
+                t->ativo = false;
+                t->proximo = roda->livres;
+                roda->livres = id;
+                roda->quantidade--;
+            }
+            id = proximo;
+        }
+    }
+
+    return total < max_expirados ? total : max_expirados;
+}
+
+// Lista os temporizadores ativos ordenados pelo prazo (para a interface; n pequeno)
+int temporizadores_listar(const roda_temporizadores_t *roda, uint16_t *ids, int max_ids) {
+    int n = 0;
+    for (int id = 0; id < TEMPORIZADORES_MAX && n < max_ids; id++) {
+        if (!roda->temporizadores[id].ativo) {
+            continue;
+        }
+        int i = n++;
+        while (i > 0 && roda->temporizadores[ids[i - 1]].prazo_ms > roda->temporizadores[id].prazo_ms) {
+            ids[i] = ids[i - 1];
+            i--;
+        }
+        ids[i] = id;
+    }
+    return n;
+}
+
+const temporizador_t *temporizadores_obter(const roda_temporizadores_t *roda, int id) {
+    if (id < 0 || id >= TEMPORIZADORES_MAX || !roda->temporizadores[id].ativo) {
+        return NULL;
+    }
+    return &roda->temporizadores[id];
+}
+
+int temporizadores_exportar(const roda_temporizadores_t *roda, uint64_t agora_ms, temporizador_salvo_t *salvos, int max_salvos) {
+    int n = 0;
+    for (int id = 0; id < TEMPORIZADORES_MAX && n < max_salvos; id++) {
+        const temporizador_t *t = &roda->temporizadores[id];
+        if (!t->ativo) {
+            continue;
+        }
+        uint64_t restante = (t->prazo_ms > agora_ms) ? t->prazo_ms - agora_ms : 0;
+        salvos[n].restante_ms = (restante > UINT32_MAX) ? UINT32_MAX : (uint32_t)restante;
+        salvos[n].periodo_ms = t->periodo_ms;
+        n++;
+    }
+    return n;
+}
+
+void temporizadores_importar(roda_temporizadores_t *roda, uint64_t agora_ms, const temporizador_salvo_t *salvos, int quantidade) {
+    for (int i = 0; i < quantidade; i++) {
+        temporizadores_adicionar(roda, agora_ms + salvos[i].restante_ms, salvos[i].periodo_ms);
+    }
+}
+
+int temporizadores_descontar(temporizador_salvo_t *salvos, int quantidade, uint32_t decorrido_ms, uint32_t parado_ms, int *perdidos) {
+    uint32_t executado_ms = (decorrido_ms > parado_ms) ? decorrido_ms - parado_ms : 0;
+    int n = 0;
+    *perdidos = 0;
+    for (int i = 0; i < quantidade; i++) {
+        temporizador_salvo_t salvo = salvos[i];
+        if (salvo.restante_ms > decorrido_ms) {
+            salvo.restante_ms -= decorrido_ms;
+        } else if (salvo.periodo_ms == 0) {
+            // Disparo único: vencido antes do reset já disparou, depois dispara agora
+            if (salvo.restante_ms <= executado_ms) {
+                continue;
+            }
+            salvo.restante_ms = 0;
+        } else {
+            // Último vencimento até agora e o seguinte, na mesma fase da gravação
+            uint64_t ultimo = salvo.restante_ms + (uint64_t)(decorrido_ms - salvo.restante_ms) / salvo.periodo_ms * salvo.periodo_ms;
+            salvo.restante_ms = (uint32_t)(ultimo + salvo.periodo_ms - decorrido_ms);
+            if (ultimo > executado_ms) {
+                (*perdidos)++;
+            }
+        }
+        salvos[n++] = salvo;
+    }
+    return n;
+}
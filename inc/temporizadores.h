@@ -0,0 +1,59 @@
+#ifndef temporizadores_inc_h
+#define temporizadores_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Roda de temporizadores hierárquica (4 níveis de 64 posições) para os lembretes de
+// medicação. Prazos em ms de 64 bits (sem o estouro de ~49 dias do contador de 32 bits),
+// inserção, cancelamento e expiração em O(1). Resolução de 1 tick; o nível 3 cobre
+// 64^4 ticks (~194 dias) e prazos maiores são reinseridos ao descer de nível.
+#ifndef TEMPORIZADORES_MAX
+#define TEMPORIZADORES_MAX 32
+#endif
+#define TEMPORIZADORES_TICK_MS 1000
+#define TEMPORIZADORES_NIVEIS 4
+#define TEMPORIZADORES_BITS_NIVEL 6
+#define TEMPORIZADORES_POSICOES (1 << TEMPORIZADORES_BITS_NIVEL)
+#define TEMPORIZADOR_NENHUM 0xFFFF
+
+typedef struct {
+    uint64_t prazo_ms;   // Instante de disparo (ms desde o boot)
+    uint32_t periodo_ms; // Intervalo de repetição (0 = dispara uma vez)
+    uint16_t proximo;    // Encadeamento na lista da posição (ou na lista livre)
+    uint16_t anterior;
+    uint16_t lista;      // Posição da roda em que está (nível * 64 + posição)
+    bool ativo;
+} temporizador_t;
+
+typedef struct {
+    temporizador_t temporizadores[TEMPORIZADORES_MAX];
+    uint16_t listas[TEMPORIZADORES_NIVEIS * TEMPORIZADORES_POSICOES];
+    uint16_t livres;
+    uint16_t quantidade;
+    uint64_t tick_atual;
+} roda_temporizadores_t;
+
+// Formato persistido: tempo restante relativo, pois o relógio recomeça a cada boot.
+// Restantes acima de ~49,7 dias são saturados em UINT32_MAX (os lembretes vão até 8 h).
+typedef struct {
+    uint32_t restante_ms;
+    uint32_t periodo_ms;
+} temporizador_salvo_t;
+
+void temporizadores_init(roda_temporizadores_t *roda, uint64_t agora_ms);
+int temporizadores_adicionar(roda_temporizadores_t *roda, uint64_t prazo_ms, uint32_t periodo_ms);
+bool temporizadores_cancelar(roda_temporizadores_t *roda, int id);
+int temporizadores_avancar(roda_temporizadores_t *roda, uint64_t agora_ms, uint16_t *expirados, int max_expirados);
+int temporizadores_listar(const roda_temporizadores_t *roda, uint16_t *ids, int max_ids);
+const temporizador_t *temporizadores_obter(const roda_temporizadores_t *roda, int id);
+int temporizadores_exportar(const roda_temporizadores_t *roda, uint64_t agora_ms, temporizador_salvo_t *salvos, int max_salvos);
+void temporizadores_importar(roda_temporizadores_t *roda, uint64_t agora_ms, const temporizador_salvo_t *salvos, int quantidade);
+// Desconta dos registros gravados há decorrido_ms o tempo passado, mantendo a fase dos
+// recorrentes (os disparos não regravam a flash). Nos últimos parado_ms o firmware não
+// executou (reset): um vencimento nesse intervalo foi perdido, os anteriores já foram
+// tratados. Retorna a nova quantidade (os de disparo único já tratados saem) e em
+// perdidos os recorrentes com disparo perdido; um único perdido fica com restante 0
+int temporizadores_descontar(temporizador_salvo_t *salvos, int quantidade, uint32_t decorrido_ms, uint32_t parado_ms, int *perdidos);
+
+#endif
@@ -0,0 +1,89 @@
+#include "tendencia.h"
+
+#define Q16(x) ((int32_t)(x) << 16)
+
+// y += (x - y) * dt / (tau + dt): EWMA com constante de tempo fixa para qualquer dt
+static int32_t ewma(int32_t y, int32_t x, uint32_t dt_ms, uint32_t tau_ms) {
+    return y + (int32_t)((int64_t)(x - y) * dt_ms / (tau_ms + dt_ms));
+}
+
+// Soma do CUSUM limitada a zero por baixo e ao dobro do limiar por cima, para que
+// um desvio longo não demore a ser "esquecido" quando o sinal volta
+static int32_t acumular(int32_t soma, int32_t excesso, uint32_t dt_ms) {
+    int64_t nova = soma + (int64_t)excesso * dt_ms / 1000;
+    if (nova < 0) return 0;
+    if (nova > 2 * Q16(TENDENCIA_LIMIAR_BPM_S)) return 2 * Q16(TENDENCIA_LIMIAR_BPM_S);
+    return (int32_t)nova;
+}
+
+static bool proximo(int32_t a, int32_t b) {
+    int32_t diferenca = a - b;
+    return diferenca <= Q16(TENDENCIA_FOLGA_BPM) && diferenca >= -Q16(TENDENCIA_FOLGA_BPM);
+}
+
+void tendencia_init(tendencia_t *tendencia) {
+    tendencia->rapida = 0;
+    tendencia->lenta = 0;
+    tendencia->cusum_alta = 0;
+    tendencia->cusum_baixa = 0;
+    tendencia->referencia = 0;
+    tendencia->tempo_ms = 0;
+    tendencia->episodio = 0;
+    tendencia->iniciado = false;
+}
+
+int tendencia_adicionar(tendencia_t *tendencia, uint8_t media_bpm, uint32_t duracao_ms) {
+    int32_t x = Q16(media_bpm);
+    if (!tendencia->iniciado) {
+        tendencia->rapida = tendencia->lenta = x;
+        tendencia->iniciado = true;
+        return 0;
+    }
+
+    tendencia->rapida = ewma(tendencia->rapida, x, duracao_ms, TENDENCIA_TAU_RAPIDA_MS);
+    tendencia->lenta = ewma(tendencia->lenta, x, duracao_ms, TENDENCIA_TAU_LENTA_MS);
+
+    // Episódio em curso: termina com a volta à referência anterior ou quando a
+    // referência lenta absorve o novo nível (sinal estável nele, e não só a média
+    // rápida cruzando a lenta no caminho de volta)
+    if (tendencia->episodio != 0) {
+        if (proximo(tendencia->rapida, tendencia->referencia)) {
+            tendencia->lenta = tendencia->referencia;
+            tendencia->episodio = 0;
+        } else if (proximo(tendencia->rapida, tendencia->lenta) && proximo(x, tendencia->lenta)) {
+            tendencia->episodio = 0;
+        }
+        return 0;
+    }
+
+    int32_t desvio = x - tendencia->lenta;
+    tendencia->cusum_alta = acumular(tendencia->cusum_alta, desvio - Q16(TENDENCIA_FOLGA_BPM), duracao_ms);
+    tendencia->cusum_baixa = acumular(tendencia->cusum_baixa, -desvio - Q16(TENDENCIA_FOLGA_BPM), duracao_ms);
+
+    if (tendencia->tempo_ms < TENDENCIA_AQUECIMENTO_MS) {
+        tendencia->tempo_ms += duracao_ms;
+        return 0;
+    }
+
+    int32_t inclinacao = tendencia_inclinacao_dbpm(tendencia);
+    int sentido = 0;
+    if (tendencia->cusum_alta >= Q16(TENDENCIA_LIMIAR_BPM_S) && inclinacao >= TENDENCIA_INCLINACAO_MIN_DBPM) {
+        sentido = 1;
+    } else if (tendencia->cusum_baixa >= Q16(TENDENCIA_LIMIAR_BPM_S) && inclinacao <= -TENDENCIA_INCLINACAO_MIN_DBPM) {
+        sentido = -1;
+    }
+    if (sentido != 0) {
+        tendencia->cusum_alta = 0;
+        tendencia->cusum_baixa = 0;
+        tendencia->referencia = tendencia->lenta;
+        tendencia->episodio = sentido;
+    }
+    return sentido;
+}
+
+// Numa rampa de inclinação s, cada EWMA atrasa s x tau em relação ao sinal, então
+// rápida - lenta = s x (tau_lenta - tau_rápida)
+int32_t tendencia_inclinacao_dbpm(const tendencia_t *tendencia) {
+    int64_t diferenca = (int64_t)tendencia->rapida - tendencia->lenta;
+    return (int32_t)(diferenca * 10 * 60000 / (TENDENCIA_TAU_LENTA_MS - TENDENCIA_TAU_RAPIDA_MS) / 65536);
+}
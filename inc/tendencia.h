@@ -0,0 +1,45 @@
+#ifndef tendencia_inc_h
+#define tendencia_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Detector de tendência do BPM, complementar aos limites fixos de inc/sinais.h: percebe
+// uma subida (ou queda) lenta e sustentada, como 70 -> 110 BPM em dez minutos, que
+// nunca cruza CRIT_MAX_BPM a tempo. Processa a média móvel a cada amostra em O(1)
+// de tempo e memória, em ponto fixo (Q16), com o intervalo entre amostras variável:
+//   - EWMA lenta: referência do paciente (constante de tempo TENDENCIA_TAU_LENTA_MS)
+//   - EWMA rápida: nível atual; a diferença entre as duas estima a inclinação
+//   - CUSUM bilateral dos desvios em relação à referência, com folga TENDENCIA_FOLGA_BPM;
+//     o alerta sai quando uma das somas passa de TENDENCIA_LIMIAR_BPM_S e a inclinação
+//     tem o mesmo sentido
+// Cada alerta abre um episódio: as somas ficam zeradas e nenhum alerta sai até a
+// média rápida voltar à referência anterior ao alerta (a referência lenta volta a ela)
+// ou a referência lenta alcançar o novo nível, ambos com a folga TENDENCIA_FOLGA_BPM.
+// Assim um degrau ou uma rampa geram um alerta só, e não um por limiar acumulado.
+#define TENDENCIA_TAU_RAPIDA_MS 30000
+#define TENDENCIA_TAU_LENTA_MS 600000
+#define TENDENCIA_FOLGA_BPM 4             // Desvio tolerado sem acumular (ruído, postura)
+#define TENDENCIA_LIMIAR_BPM_S 240        // Desvio acumulado para alertar (BPM x s)
+#define TENDENCIA_INCLINACAO_MIN_DBPM 10  // Inclinação mínima no sentido do desvio (0,1 BPM/min)
+#define TENDENCIA_AQUECIMENTO_MS 60000    // Tempo para a referência se formar após o início
+
+typedef struct {
+    int32_t rapida;        // EWMA rápida (BPM, Q16)
+    int32_t lenta;         // EWMA lenta (BPM, Q16)
+    int32_t cusum_alta;    // Desvios acumulados acima da referência (BPM x s, Q16)
+    int32_t cusum_baixa;   // Desvios acumulados abaixo da referência (BPM x s, Q16)
+    int32_t referencia;    // Referência lenta no início do episódio (BPM, Q16)
+    uint32_t tempo_ms;     // Tempo de sinal processado (satura no aquecimento)
+    int8_t episodio;       // Sentido do episódio em curso (+1, -1) ou 0
+    bool iniciado;
+} tendencia_t;
+
+void tendencia_init(tendencia_t *tendencia);
+// Retorna +1 (subida) ou -1 (queda) quando o alerta dispara nesta amostra, senão 0;
+// no máximo um alerta por episódio
+int tendencia_adicionar(tendencia_t *tendencia, uint8_t media_bpm, uint32_t duracao_ms);
+// Inclinação estimada em décimos de BPM por minuto
+int32_t tendencia_inclinacao_dbpm(const tendencia_t *tendencia);
+
+#endif
@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include "trace.h"
+
+#if TRACE_ENABLED
+#include "hardware/regs/m0plus.h"
+
+trace_registro_t trace_anel[TRACE_TAMANHO];
+uint32_t trace_indice = 0;
+
+static const char *const trace_nomes[TRACE_N_EVENTOS] = TRACE_NOMES;
+
+// Configura o SysTick como contador livre de 24 bits no clock do processador
+void trace_init(void) {
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+// Envia o conteúdo do anel pelo stdio, do registro mais antigo ao mais recente:
+// "<tempo_us> <ciclos> <B|E> <evento>" entre as linhas TRACE BEGIN e TRACE END
+void trace_dump(void) {
+    uint32_t fim = trace_indice;
+    uint32_t inicio = (fim > TRACE_TAMANHO) ? fim - TRACE_TAMANHO : 0;
+
+    printf("TRACE BEGIN\n");
+    for (uint32_t i = inicio; i < fim; i++) {
+        const trace_registro_t *registro = &trace_anel[i & (TRACE_TAMANHO - 1)];
+        printf("%lu %lu %c %s\n", (unsigned long)registro->tempo_us, (unsigned long)registro->ciclos,
+               registro->fase, trace_nomes[registro->evento]);
+    }
+    printf("TRACE END\n");
+}
+#endif
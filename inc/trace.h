@@ -0,0 +1,65 @@
+#ifndef trace_inc_h
+#define trace_inc_h
+
+#include <stdint.h>
+
+// Rastreamento do caminho crítico: TRACE_BEGIN/TRACE_END gravam o instante (µs do timer)
+// e o contador de ciclos (SysTick, 1 ciclo de clk_sys) em um anel na RAM. Com
+// TRACE_ENABLED = 0 (padrão) as macros não geram código. Ativado pela opção TRACE do CMake.
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+
+// Quantidade de registros no anel (potência de 2)
+#define TRACE_TAMANHO 512
+
+// Eventos rastreados; os nomes aparecem no dump e no JSON gerado por host/trace2json
+enum trace_evento {
+    TRACE_READ_SENSORS,
+    TRACE_VERIFICAR_ALERTAS,
+    TRACE_PROCESS_COMMAND,
+    TRACE_RENDER_ON_DISPLAY,
+    TRACE_N_EVENTOS
+};
+
+#define TRACE_NOMES { \
+    "read_sensors", \
+    "verificar_alertas", \
+    "process_command", \
+    "render_on_display" \
+}
+
+typedef struct {
+    uint32_t tempo_us;
+    uint32_t ciclos;  // Valor do SysTick (24 bits, decrescente)
+    uint8_t evento;
+    char fase;        // 'B' (início) ou 'E' (fim)
+} trace_registro_t;
+
+#if TRACE_ENABLED
+#include "hardware/timer.h"
+#include "hardware/structs/systick.h"
+
+extern trace_registro_t trace_anel[TRACE_TAMANHO];
+extern uint32_t trace_indice;
+
+// Gravação inline: duas leituras de registrador e quatro escritas na RAM
+static inline void trace_registrar(uint8_t evento, char fase) {
+    trace_registro_t *registro = &trace_anel[trace_indice++ & (TRACE_TAMANHO - 1)];
+    registro->tempo_us = timer_hw->timerawl;
+    registro->ciclos = systick_hw->cvr;
+    registro->evento = evento;
+    registro->fase = fase;
+}
+
+void trace_init(void);
+void trace_dump(void);
+
+#define TRACE_BEGIN(evento) trace_registrar((evento), 'B')
+#define TRACE_END(evento) trace_registrar((evento), 'E')
+#else
+#define TRACE_BEGIN(evento) ((void)0)
+#define TRACE_END(evento) ((void)0)
+#endif
+
+#endif
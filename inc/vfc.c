@@ -0,0 +1,126 @@
+#include "vfc.h"
+
+#define VFC_SEM_PAR 0x8000u
+
+static uint32_t quadrado_diferenca(uint16_t a, uint16_t b) {
+    int32_t d = (int32_t)a - b;
+    return (uint32_t)(d * d);
+}
+
+static bool acima_nn50(uint16_t a, uint16_t b) {
+    return a > b + VFC_LIMIAR_NN50_MS || b > a + VFC_LIMIAR_NN50_MS;
+}
+
+// Raiz quadrada inteira arredondada para o inteiro mais próximo, bit a bit
+static uint32_t raiz(uint64_t x) {
+    uint64_t resultado = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= resultado + bit) {
+            x -= resultado + bit;
+            resultado = (resultado >> 1) + bit;
+        } else {
+            resultado >>= 1;
+        }
+        bit >>= 2;
+    }
+    // Aqui x = resto; (r + 0.5)² = r² + r + 0.25
+    return (uint32_t)(x > resultado ? resultado + 1 : resultado);
+}
+
+void vfc_init(vfc_t *vfc, uint32_t janela_ms) {
+    if (janela_ms < VFC_JANELA_MIN_MS) janela_ms = VFC_JANELA_MIN_MS;
+    if (janela_ms > VFC_JANELA_MAX_MS) janela_ms = VFC_JANELA_MAX_MS;
+    vfc->inicio = 0;
+    vfc->quantidade = 0;
+    vfc->janela_ms = janela_ms;
+    vfc->soma_ms = 0;
+    vfc->soma_quadrados = 0;
+    vfc->soma_diferencas2 = 0;
+    vfc->diferencas = 0;
+    vfc->nn50 = 0;
+    vfc->encadear = false;
+}
+
+// Retira o IBI mais antigo; o par que ele formava com o seguinte sai junto
+static void remover_mais_antigo(vfc_t *vfc) {
+    uint16_t ibi = vfc->ibis[vfc->inicio] & ~VFC_SEM_PAR;
+    vfc->inicio = (vfc->inicio + 1) % VFC_BATIMENTOS_MAX;
+    vfc->quantidade--;
+    vfc->soma_ms -= ibi;
+    vfc->soma_quadrados -= (uint32_t)ibi * ibi;
+
+    if (vfc->quantidade > 0) {
+        uint16_t *seguinte = &vfc->ibis[vfc->inicio];
+        if (!(*seguinte & VFC_SEM_PAR)) {
+            vfc->soma_diferencas2 -= quadrado_diferenca(*seguinte, ibi);
+            vfc->diferencas--;
+            vfc->nn50 -= acima_nn50(*seguinte, ibi);
+            *seguinte |= VFC_SEM_PAR; // Agora é o primeiro da janela
+        }
+    }
+}
+
+void vfc_adicionar(vfc_t *vfc, uint16_t ibi_ms) {
+    if (ibi_ms < VFC_IBI_MIN_MS || ibi_ms > VFC_IBI_MAX_MS) {
+        vfc_interromper(vfc);
+        return;
+    }
+
+    if (vfc->quantidade == VFC_BATIMENTOS_MAX) {
+        remover_mais_antigo(vfc);
+    }
+
+    uint16_t registro = ibi_ms;
+    if (vfc->encadear && vfc->quantidade > 0) {
+        uint16_t anterior = vfc->ibis[(vfc->inicio + vfc->quantidade - 1) % VFC_BATIMENTOS_MAX] & ~VFC_SEM_PAR;
+        vfc->soma_diferencas2 += quadrado_diferenca(ibi_ms, anterior);
+        vfc->diferencas++;
+        vfc->nn50 += acima_nn50(ibi_ms, anterior);
+    } else {
+        registro |= VFC_SEM_PAR;
+    }
+
+    vfc->ibis[(vfc->inicio + vfc->quantidade) % VFC_BATIMENTOS_MAX] = registro;
+    vfc->quantidade++;
+    vfc->soma_ms += ibi_ms;
+    vfc->soma_quadrados += (uint32_t)ibi_ms * ibi_ms;
+    vfc->encadear = true;
+
+    // Desliza a janela: mantém os batimentos mais recentes que cabem em janela_ms
+    while (vfc->soma_ms > vfc->janela_ms) {
+        remover_mais_antigo(vfc);
+    }
+}
+
+void vfc_interromper(vfc_t *vfc) {
+    vfc->encadear = false;
+}
+
+// Desvio padrão amostral: sqrt((n * soma(x²) - soma(x)²) / (n * (n - 1)))
+uint16_t vfc_sdnn_ms(const vfc_t *vfc) {
+    uint32_t n = vfc->quantidade;
+    if (n < 2) {
+        return 0;
+    }
+    uint64_t numerador = n * vfc->soma_quadrados - (uint64_t)vfc->soma_ms * vfc->soma_ms;
+    uint64_t denominador = (uint64_t)n * (n - 1);
+    return raiz((numerador + denominador / 2) / denominador);
+}
+
+uint16_t vfc_rmssd_ms(const vfc_t *vfc) {
+    if (vfc->diferencas == 0) {
+        return 0;
+    }
+    return raiz((vfc->soma_diferencas2 + vfc->diferencas / 2) / vfc->diferencas);
+}
+
+uint8_t vfc_pnn50_pct(const vfc_t *vfc) {
+    if (vfc->diferencas == 0) {
+        return 0;
+    }
+    return (uint8_t)(((uint32_t)vfc->nn50 * 100 + vfc->diferencas / 2) / vfc->diferencas);
+}
@@ -0,0 +1,47 @@
+#ifndef vfc_inc_h
+#define vfc_inc_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Variabilidade da frequência cardíaca (VFC) no domínio do tempo sobre uma janela
+// deslizante de 1 a 5 minutos de intervalos entre batimentos (IBI):
+//   - SDNN: desvio padrão dos IBIs
+//   - RMSSD: raiz da média dos quadrados das diferenças entre IBIs sucessivos
+//   - pNN50: fração das diferenças sucessivas maiores que 50 ms
+// Cada batimento atualiza somas inteiras exatas (entrada do novo IBI e saída dos que
+// deixaram a janela) em O(1) amortizado. Com inteiros as remoções não acumulam erro,
+// que é o problema que o Welford resolve em ponto flutuante. As raízes só são
+// calculadas na leitura das métricas.
+#define VFC_JANELA_MIN_MS 60000
+#define VFC_JANELA_MAX_MS 300000
+#define VFC_IBI_MIN_MS 250              // 240 BPM
+#define VFC_IBI_MAX_MS 3000             // 20 BPM; intervalos maiores são lacunas no sinal
+#define VFC_LIMIAR_NN50_MS 50
+
+// Capacidade para 5 minutos a 200 BPM (2 KB)
+#define VFC_BATIMENTOS_MAX 1024
+
+typedef struct {
+    uint16_t ibis[VFC_BATIMENTOS_MAX]; // Anel de IBIs (ms); bit 15: não forma par com o anterior
+    uint16_t inicio;                   // IBI mais antigo
+    uint16_t quantidade;
+    uint32_t janela_ms;
+    uint32_t soma_ms;                  // Soma dos IBIs (duração coberta pela janela)
+    uint64_t soma_quadrados;           // Soma dos IBIs ao quadrado
+    uint64_t soma_diferencas2;         // Soma dos quadrados das diferenças sucessivas
+    uint16_t diferencas;               // Pares sucessivos na janela
+    uint16_t nn50;                     // Pares com diferença acima de VFC_LIMIAR_NN50_MS
+    bool encadear;                     // O próximo IBI forma par com o último
+} vfc_t;
+
+void vfc_init(vfc_t *vfc, uint32_t janela_ms);
+void vfc_adicionar(vfc_t *vfc, uint16_t ibi_ms);
+// Lacuna no sinal (fora do monitoramento, IBI inválido): o próximo IBI não forma par
+void vfc_interromper(vfc_t *vfc);
+
+uint16_t vfc_sdnn_ms(const vfc_t *vfc);
+uint16_t vfc_rmssd_ms(const vfc_t *vfc);
+uint8_t vfc_pnn50_pct(const vfc_t *vfc);
+
+#endif
@@ -10,7 +10,21 @@
 #include "hardware/i2c.h"
 #include "hardware/adc.h"
 #include "hardware/pwm.h"
+#include "hardware/watchdog.h"
 #include "inc/ssd1306.h"
+#include "inc/grafico_bpm.h"
+#include "inc/energia.h"
+#include "inc/buzzer.h"
+#include "inc/temporizadores.h"
+#include "inc/persistencia.h"
+#include "inc/trace.h"
+#include "inc/sinais.h"
+#include "inc/tendencia.h"
+#include "inc/vfc.h"
+#include "inc/formato.h"
+#include "inc/reinicio.h"
+#include "inc/telemetria.h"
+#include "inc/espelho.h"
 
 // Definições dos pinos
 #define BUTTONA_PIN 5
@@ -20,11 +34,6 @@
 #define BUZZER 21
 #define EIXO_Y 26  // ADC0 - (Utilizado para BPM e para ajuste do alarme)
 #define EIXO_X 27  // ADC1 - Utilizado para modo de ajuste (horas ou minutos)
-#define PWM_WRAP 4095    // 12 bits (4096 valores)
-
-// Variáveis do I2C
-const uint I2C_SDA = 14;
-const uint I2C_SCL = 15;
 
 // Constantes para o ADC
 #define ADC_VREF 3.3f
@@ -32,23 +41,26 @@ const uint I2C_SCL = 15;
 #define ADC_CONVERT (ADC_VREF / (ADC_RANGE - 1))
 
 // Constantes para o menu
-#define MENU_ITEMS 2
+#define MENU_ITEMS 3
 #define DEBOUNCE_TIME_US 200000 // 200 ms debounce
 
-// Limites para alertas dos sensores
-#define MIN_BPM 50
-#define MAX_BPM 80
-#define CRIT_MIN_BPM 40  
-#define CRIT_MAX_BPM 120 
-#define GIROSCOPIO_QUEDA_MIN 500  
-#define GIROSCOPIO_QUEDA_MAX 3500
-#define GIROSCOPIO_INCLINADO_MIN 1000
-#define GIROSCOPIO_INCLINADO_MAX 3000 
-
-// Definições para o sistema de média móvel e histerese
-#define AMOSTRAS_BPM 10                 // Número de amostras para média móvel
-#define TEMPO_HISTERESE_MS 2000         // Tempo mínimo em estado de alarme para acionar
-#define INTERVALO_AMOSTRAGEM_MS 200     // Intervalo entre amostras (200ms = 5 amostras/segundo)
+// Limites dos alertas, janela da média móvel e faixa do intervalo de amostragem
+// (adaptativo, 100 ms a 1 s) ficam em inc/sinais.h
+
+// Tempo de exibição da mensagem inicial (não bloqueia a amostragem)
+#define TEMPO_SPLASH_MS 2000
+
+// Os disparos dos lembretes não gravam a flash (a fase é refeita a partir do período);
+// ela só é regravada uma vez por dia, para o tempo desde a gravação caber nos 32 bits
+// do estado de reinício
+#define LEMBRETES_REGRAVAR_MS (24u * 3600 * 1000)
+
+// Faixa de BPM exibida no gráfico de tendência
+#define GRAFICO_BPM_MIN 30
+#define GRAFICO_BPM_MAX 130
+
+// Janela deslizante das métricas de variabilidade (RMSSD, SDNN, pNN50)
+#define JANELA_VFC_MS 300000
 
 // Variáveis globais de controle de menu e alertas
 absolute_time_t last_interrupt_time = 0;
@@ -60,17 +72,8 @@ volatile bool button_pressed = false;
 volatile bool alerta_ativo = false;
 char menu_items[MENU_ITEMS][16] = {
     "1. Monitorar",
-    "2. Alarmes"
-};
-
-// Tipo de alerta
-enum TipoAlerta {
-    SEM_ALERTA,
-    BATIMENTO_BAIXO,
-    BATIMENTO_ALTO,
-    QUEDA_DETECTADA,
-    ALARME_TEMPORIZADOR,
-    SOS_ALARME       
+    "2. Alarmes",
+    "3. Lembretes"
 };
 
 volatile enum TipoAlerta alerta_atual = SEM_ALERTA;
@@ -82,54 +85,87 @@ uint8_t bpm = 65;
 uint8_t bpm_instantaneo = 65;
 
 // Variáveis para o sistema de média móvel e histerese
-uint8_t buffer_bpm[AMOSTRAS_BPM];      // Buffer circular para armazenar amostras de BPM
-uint8_t indice_buffer = 0;             // Índice atual no buffer circular
-uint8_t amostras_coletadas = 0;        // Contador de amostras coletadas
+media_bpm_t media_movel_bpm;           // Buffer circular das amostras de BPM
 uint8_t media_bpm = 65;                // Média atual de BPM
-
-// Variáveis para controle de histerese
-uint32_t inicio_estado_critico_ms = 0;  // Timestamp de quando o estado crítico começou
-bool estado_critico = false;            // Flag para indicar se está em estado crítico
-uint32_t ultimo_tempo_amostragem = 0;   // Último tempo em que uma amostra foi coletada
+grafico_bpm_t grafico_bpm;             // Tendência das últimas 128 médias
+avaliador_alertas_t avaliador_alertas; // Estado da histerese do BPM crítico
+tendencia_t tendencia_bpm;             // Detector de subida/queda sustentada da média
+int tendencia_pendente = 0;            // Tendência detectada ainda não exibida (+1 subida, -1 queda)
+int tendencia_exibida = 0;             // Sentido da tendência na tela de alerta
+vfc_t vfc_bpm;                         // Intervalos entre batimentos e métricas de VFC
+volatile bool pagina_vfc = false;      // Monitoramento exibindo a página de VFC (botão A alterna)
+uint32_t fase_batimento = 0;           // BPM x ms acumulados desde o último batimento simulado
+uint32_t ultimo_batimento_ms = 0;      // Instante do último batimento simulado
+bool ultimo_batimento_valido = false;  // Há um batimento anterior para formar o IBI
+uint32_t ultima_leitura_batimentos_ms = 0;
+uint32_t ultimo_tempo_amostragem = 0;  // Último tempo em que uma amostra foi coletada
+uint32_t intervalo_amostragem_ms = INTERVALO_AMOSTRAGEM_MIN_MS; // Intervalo até a próxima amostra
 
 // --- Variáveis para o alarme configurável ---
-volatile bool alarm_active = false;                  // Indica se o alarme já foi confirmado e está em contagem
 volatile uint32_t alarm_set_seconds = 60;            // Tempo configurado (inicia com 1 minuto)
-volatile uint32_t alarm_trigger_time_ms = 0;         // Momento (em ms) em que o alarme disparará
 volatile bool confirm_alarm = false;                 // Flag definida ao confirmar a configuração
 uint32_t last_alarm_input_time = 0;                  // Debounce para ajustes do alarme
 bool adjust_hours = false;                           
 
-// Função para adicionar uma nova amostra de BPM e calcular a média móvel
-void atualizar_media_bpm(uint8_t nova_amostra) {
-    // Adiciona a nova amostra ao buffer circular
-    buffer_bpm[indice_buffer] = nova_amostra;
-    indice_buffer = (indice_buffer + 1) % AMOSTRAS_BPM;
-    
-    // Incrementa contador de amostras coletadas (até o máximo do tamanho do buffer)
-    if (amostras_coletadas < AMOSTRAS_BPM) {
-        amostras_coletadas++;
-    }
-    
-    // Calcula a média das amostras coletadas
-    uint16_t soma = 0;
-    for (uint8_t i = 0; i < amostras_coletadas; i++) {
-        soma += buffer_bpm[i];
-    }
-    
-    media_bpm = soma / amostras_coletadas;
-}
+// --- Lembretes de medicação (vários temporizadores recorrentes) ---
+roda_temporizadores_t lembretes;                     // Roda de temporizadores com os lembretes ativos
+volatile bool cancelar_lembrete = false;             // Flag definida ao cancelar o lembrete selecionado
+volatile bool lembretes_cheia = false;               // A última confirmação não coube na roda
+bool lembrete_pendente = false;                      // Lembrete venceu enquanto outro alerta estava ativo
+uint8_t lembrete_selecionado = 0;                    // Posição selecionada na lista de lembretes
+uint32_t last_lembrete_input_time = 0;               // Debounce para a navegação na lista
+uint64_t ultimo_salvamento_ms = 0;                   // Última gravação dos lembretes na flash
+
+#if TELEMETRIA_ENABLED
+telemetria_t telemetria;                             // Lotes de sinais vitais e alertas para envio por Wi-Fi
+#endif
+
+// Instante (desde o reset) da primeira avaliação de alertas, para medir o tempo de boot
+// (o boot a frio já começa no monitoramento, então não inclui nenhuma navegação)
+uint64_t tempo_primeira_avaliacao_us = 0;
 
 // Inicializa o sistema de média móvel de BPM
 void inicializar_sistema_bpm() {
-    // Inicializa o buffer de BPM com o valor padrão
-    for (int i = 0; i < AMOSTRAS_BPM; i++) {
-        buffer_bpm[i] = 65;  // Valor inicial de BPM
-    }
-    
+    sinais_media_init(&media_movel_bpm);
+    sinais_avaliador_init(&avaliador_alertas);
+    tendencia_init(&tendencia_bpm);
+    vfc_init(&vfc_bpm, JANELA_VFC_MS);
+    grafico_bpm_init(&grafico_bpm, GRAFICO_BPM_MIN, GRAFICO_BPM_MAX);
     ultimo_tempo_amostragem = to_ms_since_boot(get_absolute_time());
 }
 
+// Botões que acordam o sistema do modo dormente
+const uint botoes_despertar[] = {BUTTONA_PIN, BUTTONB_PIN, JOYSTICK_BUTTON};
+
+// Liga o buzzer com o padrão sonoro do alerta atual (tocado pelo sequenciador em buzzer.c);
+// em silêncio o slice do PWM fica desabilitado, evitando consumo
+void buzzer_ligar() {
+    switch (alerta_atual) {
+        case BATIMENTO_BAIXO:
+        case BATIMENTO_ALTO:
+            buzzer_tocar(&buzzer_padrao_cardiaco_alta);
+            break;
+        case TENDENCIA_BPM:
+            buzzer_tocar(&buzzer_padrao_cardiaco_media);
+            break;
+        case QUEDA_DETECTADA:
+            buzzer_tocar(&buzzer_padrao_geral_alta);
+            break;
+        case ALARME_TEMPORIZADOR:
+            buzzer_tocar(&buzzer_padrao_medicacao_media);
+            break;
+        case SOS_ALARME:
+            buzzer_tocar(&buzzer_padrao_sos);
+            break;
+        default:
+            break;
+    }
+}
+
+void buzzer_desligar() {
+    buzzer_parar();
+}
+
 // Função de callback para interrupções dos botões
 void gpio_callback(uint gpio, uint32_t events) {
     absolute_time_t current_time = get_absolute_time();
@@ -138,6 +174,13 @@ void gpio_callback(uint gpio, uint32_t events) {
     }
     last_interrupt_time = current_time;
     
+    // Com o display apagado, A e B apenas reacendem a tela (o SOS nunca é ignorado)
+    bool display_apagado = energia_display_apagado();
+    energia_registrar_atividade();
+    if (display_apagado && gpio != JOYSTICK_BUTTON) {
+        return;
+    }
+    
     if (gpio == BUTTONA_PIN) {
         if (menu_active && !submenu_active && !alerta_ativo) {
             // Entra no submenu a partir do menu principal
@@ -148,40 +191,40 @@ void gpio_callback(uint gpio, uint32_t events) {
             alerta_ativo = false;
             alerta_atual = SEM_ALERTA;
             gpio_put(RED_PIN, 0);
-            pwm_set_gpio_level(BUZZER, 0);
+            buzzer_desligar();
+        } else if (submenu_active && submenu_index == 0) {
+            // Botão A alterna entre as páginas de BPM e de VFC do monitoramento
+            pagina_vfc = !pagina_vfc;
         } else if (submenu_active && submenu_index == 1) {
-            if (alarm_active) {
-                alarm_active = false;
-                alarm_set_seconds = 60;
-                gpio_put(RED_PIN, 0);
-                pwm_set_gpio_level(BUZZER, 0);
-            } else {
-                // Se o alarme ainda não estiver ativo, botão A confirma a configuração do alarme
-                confirm_alarm = true;
-            }
+            // Botão A confirma a configuração, criando um novo lembrete recorrente
+            confirm_alarm = true;
+        } else if (submenu_active && submenu_index == 2) {
+            // Botão A cancela o lembrete selecionado na lista
+            cancelar_lembrete = true;
         }
         button_pressed = true;
     } else if (gpio == BUTTONB_PIN) {
         if (submenu_active && !alerta_ativo) {
             // B: Retorna ao menu principal
             submenu_active = false;
-            // Se estiver no submenu de alarme e o alarme não estiver ativo, reinicia o tempo configurado
-            if (submenu_index == 1 && !alarm_active) {
+            // Se estiver no submenu de alarme, reinicia o tempo configurado
+            if (submenu_index == 1) {
                 alarm_set_seconds = 60;
+                lembretes_cheia = false;
             }
         } else if (alerta_ativo) {
             // Desativa alerta
             alerta_ativo = false;
             alerta_atual = SEM_ALERTA;
             gpio_put(RED_PIN, 0);
-            pwm_set_gpio_level(BUZZER, 0);
+            buzzer_desligar();
         }
         button_pressed = true;
     } else if (gpio == JOYSTICK_BUTTON) {
         alerta_ativo = true;
         alerta_atual = SOS_ALARME;
         gpio_put(RED_PIN, 1);
-        pwm_set_gpio_level(BUZZER, PWM_WRAP / 2);
+        buzzer_ligar();
         button_pressed = true;
     }
 }
@@ -189,48 +232,58 @@ void gpio_callback(uint gpio, uint32_t events) {
 // Função para verificar alertas dos sensores com histerese
 void verificar_alertas() {
     if (!submenu_active || submenu_index != 0 || alerta_ativo) return;
+    TRACE_BEGIN(TRACE_VERIFICAR_ALERTAS);
+    if (tempo_primeira_avaliacao_us == 0) {
+        tempo_primeira_avaliacao_us = time_us_64();
+    }
     
     uint32_t tempo_atual = to_ms_since_boot(get_absolute_time());
-    
-    // Verifica se o BPM está fora dos limites críticos
-    bool bpm_critico = (media_bpm < CRIT_MIN_BPM || media_bpm > CRIT_MAX_BPM);
-    
-    // Se não estava em estado crítico e agora está, registra o início
-    if (!estado_critico && bpm_critico) {
-        estado_critico = true;
-        inicio_estado_critico_ms = tempo_atual;
+    enum TipoAlerta alerta = sinais_avaliar_alertas(&avaliador_alertas, media_bpm, adc_x, tempo_atual);
+    // A tendência tem prioridade menor que os limites fixos e a queda
+    if (alerta == SEM_ALERTA && tendencia_pendente != 0) {
+        alerta = TENDENCIA_BPM;
+        tendencia_exibida = tendencia_pendente;
+        tendencia_pendente = 0;
     }
-    // Se estava em estado crítico e não está mais, reseta o estado
-    else if (estado_critico && !bpm_critico) {
-        estado_critico = false;
+    if (alerta != SEM_ALERTA) {
+        alerta_ativo = true;
+        alerta_atual = alerta;
+        gpio_put(RED_PIN, 1);
+        buzzer_ligar();
     }
-    
-    // Se está em estado crítico e já passou o tempo de histerese, aciona o alarme
-    if (estado_critico && (tempo_atual - inicio_estado_critico_ms >= TEMPO_HISTERESE_MS)) {
-        if (media_bpm < CRIT_MIN_BPM) {
-            alerta_ativo = true;
-            alerta_atual = BATIMENTO_BAIXO;
-            gpio_put(RED_PIN, 1);
-            pwm_set_gpio_level(BUZZER, PWM_WRAP / 2);
-        } else if (media_bpm > CRIT_MAX_BPM) {
-            alerta_ativo = true;
-            alerta_atual = BATIMENTO_ALTO;
-            gpio_put(RED_PIN, 1);
-            pwm_set_gpio_level(BUZZER, PWM_WRAP / 2);
-        }
+    TRACE_END(TRACE_VERIFICAR_ALERTAS);
+}
+
+// Batimentos simulados a partir do BPM instantâneo (o joystick faz o papel do sensor):
+// a fase acumula BPM x ms e cada 60000 é um batimento, com o instante interpolado dentro
+// do intervalo entre leituras, de modo que o IBI não depende do ritmo do laço principal
+void simular_batimentos(uint32_t tempo_atual) {
+    uint32_t decorrido = tempo_atual - ultima_leitura_batimentos_ms;
+    ultima_leitura_batimentos_ms = tempo_atual;
+    
+    // Fora do monitoramento o joystick navega nos menus: o sinal é interrompido
+    if (!(submenu_active && submenu_index == 0)) {
+        fase_batimento = 0;
+        ultimo_batimento_valido = false;
+        vfc_interromper(&vfc_bpm);
+        return;
     }
     
-    // Verificação da queda permanece a mesma
-    if (adc_x < GIROSCOPIO_QUEDA_MIN || adc_x > GIROSCOPIO_QUEDA_MAX) {
-        alerta_ativo = true;
-        alerta_atual = QUEDA_DETECTADA;
-        gpio_put(RED_PIN, 1);
-        pwm_set_gpio_level(BUZZER, PWM_WRAP / 2);
+    fase_batimento += (uint32_t)bpm_instantaneo * decorrido;
+    while (fase_batimento >= 60000) {
+        fase_batimento -= 60000;
+        uint32_t instante = tempo_atual - fase_batimento / bpm_instantaneo;
+        if (ultimo_batimento_valido) {
+            vfc_adicionar(&vfc_bpm, instante - ultimo_batimento_ms);
+        }
+        ultimo_batimento_ms = instante;
+        ultimo_batimento_valido = true;
     }
 }
 
 // Função para ler os sensores com conversão e atualização da média móvel
 void read_sensors() {
+    TRACE_BEGIN(TRACE_READ_SENSORS);
     adc_select_input(1);
     adc_x = adc_read();
     
@@ -240,18 +293,26 @@ void read_sensors() {
     uint32_t tempo_atual = to_ms_since_boot(get_absolute_time());
     
     // Calcula o BPM instantâneo com base na leitura do ADC
-    if (adc_y < 1000) {
-        bpm_instantaneo = (uint8_t)(adc_y * 0.04);
-    } else if (adc_y > 3000) {
-        float excesso = adc_y - 3000;
-        bpm_instantaneo = 80 + (uint8_t)(excesso * 0.04);
-    } else {
-        bpm_instantaneo = 50 + (uint8_t)((adc_y - 1000) * 0.015);
-    }
-    
-    // Atualiza a média móvel em intervalos regulares
-    if (tempo_atual - ultimo_tempo_amostragem >= INTERVALO_AMOSTRAGEM_MS) {
-        atualizar_media_bpm(bpm_instantaneo);
+    bpm_instantaneo = sinais_bpm_de_adc(adc_y);
+    simular_batimentos(tempo_atual);
+    
+    // Atualiza a média móvel no intervalo adaptativo, recalculado a cada amostra
+    uint32_t decorrido = tempo_atual - ultimo_tempo_amostragem;
+    if (decorrido >= intervalo_amostragem_ms) {
+        media_bpm = sinais_media_adicionar(&media_movel_bpm, bpm_instantaneo, decorrido);
+        intervalo_amostragem_ms = sinais_intervalo_amostragem_ms(&media_movel_bpm, bpm_instantaneo);
+        // O gráfico e o detector de tendência só acompanham o sinal durante o
+        // monitoramento (nos menus o joystick é usado para navegar)
+        if (submenu_active && submenu_index == 0) {
+            grafico_bpm_adicionar(&grafico_bpm, media_bpm);
+            int sentido = tendencia_adicionar(&tendencia_bpm, media_bpm, decorrido);
+            if (sentido != 0) {
+                tendencia_pendente = sentido;
+            }
+#if TELEMETRIA_ENABLED
+            telemetria_registrar_sinais(&telemetria, tempo_atual, media_bpm, adc_x);
+#endif
+        }
         ultimo_tempo_amostragem = tempo_atual;
     }
     
@@ -259,6 +320,7 @@ void read_sensors() {
     bpm = media_bpm;
     
     verificar_alertas();
+    TRACE_END(TRACE_READ_SENSORS);
 }
 
 // Processa a navegação do menu principal
@@ -268,11 +330,13 @@ bool process_joystick_navigation() {
         if (adc_y < 1000) {
             if (menu_index > 0) {
                 menu_index--;
+                energia_registrar_atividade();
                 return true;
             }
         } else if (adc_y > 3000) {
             if (menu_index < MENU_ITEMS - 1) {
                 menu_index++;
+                energia_registrar_atividade();
                 return true;
             }
         }
@@ -282,7 +346,7 @@ bool process_joystick_navigation() {
 
 // Processa os ajustes do tempo do alarme no submenu "Alarmes" utilizando ambos os eixos
 void process_alarm_input() {
-    if (!(submenu_active && submenu_index == 1 && !alarm_active)) return;
+    if (!(submenu_active && submenu_index == 1)) return;
     
     uint32_t current_time = to_ms_since_boot(get_absolute_time());
     if (current_time - last_alarm_input_time < 250) return;
@@ -296,6 +360,11 @@ void process_alarm_input() {
     adc_select_input(1);
     uint16_t joystick_x = adc_read();
     
+    // Qualquer deflexão do joystick conta como atividade (mantém o display aceso)
+    if (joystick_x < 1000 || joystick_x > 3000 || joystick_y < 1000 || joystick_y > 3000) {
+        energia_registrar_atividade();
+    }
+    
     // Define o modo de ajuste com base no eixo X:
     if (joystick_x < 1000) {
          adjust_hours = true;
@@ -320,8 +389,65 @@ void process_alarm_input() {
     }
 }
 
+// Tempo desde o boot em ms com 64 bits (to_ms_since_boot estoura após ~49 dias)
+uint64_t agora_ms() {
+    return time_us_64() / 1000;
+}
+
+// Grava os lembretes na flash (tempo restante de cada um e período). Apagar o setor leva
+// dezenas a centenas de ms com as interrupções desabilitadas e gasta um dos ~100 mil
+// ciclos: só ao criar ou cancelar um lembrete e na regravação diária
+void salvar_lembretes() {
+    temporizador_salvo_t salvos[TEMPORIZADORES_MAX];
+    int quantidade = temporizadores_exportar(&lembretes, agora_ms(), salvos, TEMPORIZADORES_MAX);
+    persistencia_salvar(PERSISTENCIA_SETOR_LEMBRETES, salvos, quantidade * sizeof(salvos[0]));
+    ultimo_salvamento_ms = agora_ms();
+}
+
+// Restaura os lembretes gravados antes do último reinício; decorrido_ms é o tempo entre
+// a gravação e agora e parado_ms a parte final dele sem execução, do último
+// watchdog_update() até aqui (conhecidos apenas no reinício a quente, senão 0)
+void carregar_lembretes(uint32_t decorrido_ms, uint32_t parado_ms) {
+    temporizador_salvo_t salvos[TEMPORIZADORES_MAX];
+    size_t tamanho = persistencia_carregar(PERSISTENCIA_SETOR_LEMBRETES, salvos, sizeof(salvos));
+    int quantidade = tamanho / sizeof(salvos[0]);
+    
+    // Os recorrentes seguem na fase da gravação; um vencimento durante o reset vira o
+    // alerta de medicação na primeira volta do laço
+    int perdidos;
+    quantidade = temporizadores_descontar(salvos, quantidade, decorrido_ms, parado_ms, &perdidos);
+    if (perdidos > 0) {
+        lembrete_pendente = true;
+    }
+    
+    temporizadores_init(&lembretes, agora_ms());
+    temporizadores_importar(&lembretes, agora_ms(), salvos, quantidade);
+    ultimo_salvamento_ms = agora_ms();
+}
+
+// Navegação na lista de lembretes com o eixo Y do joystick
+void process_lembretes_input() {
+    if (!(submenu_active && submenu_index == 2)) return;
+    
+    uint32_t current_time = to_ms_since_boot(get_absolute_time());
+    if (current_time - last_lembrete_input_time < 250) return;
+    last_lembrete_input_time = current_time;
+    
+    adc_select_input(0);
+    uint16_t joystick_y = adc_read();
+    
+    if (joystick_y < 1000 && lembrete_selecionado > 0) {
+        lembrete_selecionado--;
+        energia_registrar_atividade();
+    } else if (joystick_y > 3000 && lembrete_selecionado + 1 < lembretes.quantidade) {
+        lembrete_selecionado++;
+        energia_registrar_atividade();
+    }
+}
+
 // Função auxiliar para atualizar o display
 void process_command(char *line1, char *line2, char *line3, char *line4, uint8_t *ssd, struct render_area *frame_area) {
+    TRACE_BEGIN(TRACE_PROCESS_COMMAND);
     memset(ssd, 0, ssd1306_buffer_length);
     render_on_display(ssd, frame_area);
     
@@ -331,6 +457,7 @@ void process_command(char *line1, char *line2, char *line3, char *line4, uint8_t
     if (line4 != NULL) ssd1306_draw_string(ssd, 5, 24, line4);
     
     render_on_display(ssd, frame_area);
+    TRACE_END(TRACE_PROCESS_COMMAND);
 }
 
 // Desenha o menu principal
@@ -340,45 +467,79 @@ void draw_menu(uint8_t *ssd, struct render_area *frame_area) {
     char line3[32] = "";
     char line4[32] = "";
     
+    char *lines[MENU_ITEMS] = {line2, line3, line4};
+    
     for (int i = 0; i < MENU_ITEMS; i++) {
-        if (i == menu_index) {
-            if (i == 0) {
-                snprintf(line2, sizeof(line2), "l %s", menu_items[i]);
-            } else if (i == 1) {
-                snprintf(line3, sizeof(line3), "l %s", menu_items[i]);
-            }
-        } else {
-            if (i == 0) {
-                snprintf(line2, sizeof(line2), "   %s", menu_items[i]);
-            } else if (i == 1) {
-                snprintf(line3, sizeof(line3), "   %s", menu_items[i]);
-            }
-        }
+        char *p = formato_texto(lines[i], (i == menu_index) ? "l " : "   ");
+        formato_fim(formato_texto(p, menu_items[i]));
     }
     
     process_command(line1, line2, line3, line4, ssd, frame_area);
 }
 
-// Submenu de monitoramento - modificado para mostrar BPM atual e média
-void draw_submenu_adc(uint8_t *ssd, struct render_area *frame_area) {
+// Submenu de monitoramento - mostra BPM atual e média nas páginas de texto;
+// o gráfico de tendência (páginas inferiores) é atualizado à parte
+void draw_submenu_adc(uint8_t *ssd, struct render_area *text_area) {
     char line1[32] = "MONITORAMENTO";
     char line2[32] = "";
     char line3[32] = "";
     char line4[32] = "";
     
     // Mostra tanto o BPM atual quanto a média
-    snprintf(line2, sizeof(line2), "BPM %d Med %d ", bpm_instantaneo, bpm);
+    char *p = formato_texto(line2, "BPM ");
+    p = formato_decimal(p, bpm_instantaneo, 0);
+    p = formato_texto(p, " Med ");
+    p = formato_decimal(p, bpm, 0);
+    formato_fim(formato_texto(p, " "));
     
     if (adc_x < GIROSCOPIO_QUEDA_MIN || adc_x > GIROSCOPIO_QUEDA_MAX) {
-        snprintf(line3, sizeof(line3), "Giro: ALERTA!");
+        strcpy(line3, "Giro: ALERTA!");
     } else if ((adc_x > GIROSCOPIO_INCLINADO_MAX && adc_x < GIROSCOPIO_QUEDA_MAX) || (adc_x < GIROSCOPIO_INCLINADO_MIN && adc_x > GIROSCOPIO_QUEDA_MIN)) {
-        snprintf(line3, sizeof(line3), "Giro: Inclinado");
+        strcpy(line3, "Giro: Inclinado");
     } else {
-        snprintf(line3, sizeof(line3), "Giro: Normal");
+        strcpy(line3, "Giro: Normal");
     }
-    snprintf(line4, sizeof(line4), "B:Voltar");
+    strcpy(line4, "A:VFC B:Voltar");
+    
+    // Limpa e envia apenas a área de texto, preservando o gráfico no buffer
+    memset(ssd, 0, GRAFICO_BPM_PAGINA_INICIAL * ssd1306_width);
+    ssd1306_draw_string(ssd, 5, 0, line1);
+    ssd1306_draw_string(ssd, 5, 8, line2);
+    ssd1306_draw_string(ssd, 5, 16, line3);
+    ssd1306_draw_string(ssd, 5, 24, line4);
+    render_on_display(ssd, text_area);
+}
+
+// Página de VFC do monitoramento: métricas da janela de JANELA_VFC_MS nas páginas de
+// texto, com o mesmo gráfico de tendência abaixo
+void draw_submenu_vfc(uint8_t *ssd, struct render_area *text_area) {
+    char line1[32] = "";
+    char line2[32] = "";
+    char line3[32] = "";
+    char line4[32] = "";
     
-    process_command(line1, line2, line3, line4, ssd, frame_area);
+    char *p = formato_texto(line1, "VFC ");
+    p = formato_decimal(p, JANELA_VFC_MS / 60000, 0);
+    formato_fim(formato_texto(p, " min"));
+    
+    p = formato_texto(line2, "RMSSD ");
+    p = formato_decimal(p, vfc_rmssd_ms(&vfc_bpm), 0);
+    formato_fim(formato_texto(p, " ms"));
+    
+    p = formato_texto(line3, "SDNN ");
+    p = formato_decimal(p, vfc_sdnn_ms(&vfc_bpm), 0);
+    formato_fim(formato_texto(p, " ms"));
+    
+    p = formato_texto(line4, "pNN50 ");
+    p = formato_decimal(p, vfc_pnn50_pct(&vfc_bpm), 0);
+    formato_fim(formato_texto(p, " A:BPM"));
+    
+    memset(ssd, 0, GRAFICO_BPM_PAGINA_INICIAL * ssd1306_width);
+    ssd1306_draw_string(ssd, 5, 0, line1);
+    ssd1306_draw_string(ssd, 5, 8, line2);
+    ssd1306_draw_string(ssd, 5, 16, line3);
+    ssd1306_draw_string(ssd, 5, 24, line4);
+    render_on_display(ssd, text_area);
 }
 
 // Submenu de alarmes com ajuste de tempo, exibição do modo e status
@@ -388,22 +549,53 @@ void draw_submenu_alarmes(uint8_t *ssd, struct render_area *frame_area) {
     char line3[32] = "";
     char line4[32] = "";
     
-    if (!alarm_active) {
-        uint32_t horas = alarm_set_seconds / 3600;
-        uint32_t minutos = (alarm_set_seconds % 3600) / 60;
-        uint32_t segundos = alarm_set_seconds % 60;
-        snprintf(line2, sizeof(line2), "Tempo %02u:%02u:%02u [%s]", horas, minutos, segundos, adjust_hours ? "H" : "M");
-        snprintf(line3, sizeof(line3), "A Confirmar");
-        snprintf(line4, sizeof(line4), "B Voltar");
+    // O tempo configurado vira o período do novo lembrete (repete até ser cancelado)
+    char *p = formato_texto(line2, "Tempo ");
+    p = formato_hhmmss(p, alarm_set_seconds);
+    formato_fim(formato_texto(p, adjust_hours ? " [H]" : " [M]"));
+    if (lembretes_cheia) {
+        strcpy(line3, "Lista cheia");
+    } else {
+        p = formato_texto(line3, "A Adicionar ");
+        formato_fim(formato_decimal(p, lembretes.quantidade, 0));
+    }
+    strcpy(line4, "B Voltar");
+    
+    process_command(line1, line2, line3, line4, ssd, frame_area);
+}
+
+// Lista de lembretes ordenada pelo próximo vencimento: tempo restante e período
+void draw_submenu_lembretes(uint8_t *ssd, struct render_area *frame_area) {
+    char line1[32] = "LEMBRETES";
+    char line2[32] = "";
+    char line3[32] = "";
+    char line4[32] = "B Voltar";
+    char *lines[2] = {line2, line3};
+    
+    uint16_t ids[TEMPORIZADORES_MAX];
+    int quantidade = temporizadores_listar(&lembretes, ids, TEMPORIZADORES_MAX);
+    uint64_t agora = agora_ms();
+    
+    if (quantidade == 0) {
+        strcpy(line2, "Nenhum");
     } else {
-        uint32_t current_ms = to_ms_since_boot(get_absolute_time());
-        uint32_t restante = (alarm_trigger_time_ms > current_ms) ? (alarm_trigger_time_ms - current_ms) / 1000 : 0;
-        uint32_t horas = restante / 3600;
-        uint32_t minutos = (restante % 3600) / 60;
-        uint32_t segundos = restante % 60;
-        snprintf(line2, sizeof(line2), "Restante");
-        snprintf(line3, sizeof(line3), "%02u:%02u:%02u", horas, minutos, segundos);
-        snprintf(line4, sizeof(line4), "BVoltar ACancelar");
+        if (lembrete_selecionado >= quantidade) {
+            lembrete_selecionado = quantidade - 1;
+        }
+        // Mostra o selecionado e o seguinte (ou o anterior, no fim da lista)
+        int primeiro = (lembrete_selecionado + 1 < quantidade || quantidade == 1) ? lembrete_selecionado : lembrete_selecionado - 1;
+        
+        for (int i = 0; i < 2 && primeiro + i < quantidade; i++) {
+            const temporizador_t *lembrete = temporizadores_obter(&lembretes, ids[primeiro + i]);
+            uint32_t restante = (lembrete->prazo_ms > agora) ? (lembrete->prazo_ms - agora) / 1000 : 0;
+            uint32_t periodo_min = lembrete->periodo_ms / 60000;
+            char *p = formato_texto(lines[i], (primeiro + i == lembrete_selecionado) ? "l " : "  ");
+            p = formato_hhmmss(p, restante);
+            p = formato_texto(p, " ");
+            p = formato_decimal(p, (periodo_min % 60 == 0) ? periodo_min / 60 : periodo_min, 0);
+            formato_fim(formato_texto(p, (periodo_min % 60 == 0) ? "h" : "m"));
+        }
+        strcpy(line4, "A Canc B Voltar");
     }
     
     process_command(line1, line2, line3, line4, ssd, frame_area);
@@ -418,41 +610,77 @@ void draw_alerta(uint8_t *ssd, struct render_area *frame_area) {
     
     switch (alerta_atual) {
         case BATIMENTO_BAIXO:
-            snprintf(line2, sizeof(line2), "BATIMENTO BAIXO");
-            snprintf(line3, sizeof(line3), "BPM: %d", media_bpm);
+            strcpy(line2, "BATIMENTO BAIXO");
+            formato_fim(formato_decimal(formato_texto(line3, "BPM: "), media_bpm, 0));
             break;
         case BATIMENTO_ALTO:
-            snprintf(line2, sizeof(line2), "BATIMENTO ALTO");
-            snprintf(line3, sizeof(line3), "BPM: %d", media_bpm);
+            strcpy(line2, "BATIMENTO ALTO");
+            formato_fim(formato_decimal(formato_texto(line3, "BPM: "), media_bpm, 0));
             break;
         case QUEDA_DETECTADA:
-            snprintf(line2, sizeof(line2), "QUEDA DETECTADA");
+            strcpy(line2, "QUEDA DETECTADA");
             break;
         case ALARME_TEMPORIZADOR:
-            snprintf(line2, sizeof(line2), "ALARME!");
-            snprintf(line3, sizeof(line3), "Tempo esgotado");
-            snprintf(line4, sizeof(line4), "Hora do remedio");
+            strcpy(line2, "ALARME!");
+            strcpy(line3, "Tempo esgotado");
+            strcpy(line4, "Hora do remedio");
             break;
         case SOS_ALARME:
-            snprintf(line2, sizeof(line2), "SOS ALARME");
-            snprintf(line3, sizeof(line3), "Ativado");
+            strcpy(line2, "SOS ALARME");
+            strcpy(line3, "Ativado");
             break;
+        case TENDENCIA_BPM: {
+            // Ex.: "BPM 92 subindo" (sem o sentido se o alerta veio de um reinício a quente)
+            strcpy(line2, "TENDENCIA BPM");
+            char *p = formato_decimal(formato_texto(line3, "BPM "), media_bpm, 0);
+            if (tendencia_exibida != 0) {
+                p = formato_texto(p, tendencia_exibida > 0 ? " subindo" : " caindo");
+            }
+            formato_fim(p);
+            break;
+        }
         default:
-            snprintf(line2, sizeof(line2), "ERRO DESCONHECIDO");
+            strcpy(line2, "ERRO DESCONHECIDO");
             break;
     }
     
     process_command(line1, line2, line3, line4, ssd, frame_area);
 }
 
+// Registra nos rascunhos do watchdog o estado a restaurar em um reinício a quente
+void salvar_estado_reinicio() {
+    uint64_t desde_salvamento = agora_ms() - ultimo_salvamento_ms;
+    estado_reinicio_t estado = {
+        .alerta = alerta_ativo ? alerta_atual : SEM_ALERTA,
+        .lembrete_pendente = lembrete_pendente,
+        .submenu_ativo = submenu_active,
+        .submenu_indice = submenu_index,
+        .pagina_vfc = pagina_vfc,
+        .menu_indice = menu_index,
+        .ms_desde_salvamento = (desde_salvamento > UINT32_MAX) ? UINT32_MAX : (uint32_t)desde_salvamento
+    };
+    reinicio_salvar(&estado);
+}
+
 int main() {
-    
-    // Inicialização do I2C e OLED
-    i2c_init(i2c1, ssd1306_i2c_clock * 4000);
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA);
-    gpio_pull_up(I2C_SCL);
+    // Reinício a quente (estouro do watchdog): a causa do reset é lida antes de
+    // watchdog_enable(), que grava a mágica do SDK e faria um watchdog_reboot() (picotool,
+    // depurador) passar por estouro
+    estado_reinicio_t reinicio;
+    bool reinicio_quente = reinicio_restaurar(&reinicio);
+    
+    // Reinicia o sistema se o laço principal travar
+    watchdog_enable(REINICIO_WATCHDOG_MS, true);
+    
+#if TRACE_ENABLED || ESPELHO_ENABLED
+    // stdio pelo USB: dump do rastreamento (comando 'T') e espelhamento do display
+    stdio_init_all();
+#endif
+#if TRACE_ENABLED
+    trace_init();
+#endif
+    
+    // Inicialização do OLED (o barramento, I2C ou SPI, é configurado pelo backend em display_*.c)
     ssd1306_init();
     
     struct render_area frame_area = {
@@ -463,17 +691,29 @@ int main() {
     };
     calculate_render_area_buffer_length(&frame_area);
     
-    uint8_t ssd[ssd1306_buffer_length];
-    memset(ssd, 0, ssd1306_buffer_length);
-    render_on_display(ssd, &frame_area);
+    // Área de texto da tela de monitoramento (acima do gráfico)
+    struct render_area text_area = {
+        .start_column = 0,
+        .end_column = ssd1306_width - 1,
+        .start_page = 0,
+        .end_page = GRAFICO_BPM_PAGINA_INICIAL - 1
+    };
+    calculate_render_area_buffer_length(&text_area);
+    
+    // Área de uma página, para enviar a mensagem inicial aos poucos
+    struct render_area splash_area = {
+        .start_column = 0,
+        .end_column = ssd1306_width - 1,
+        .start_page = 0,
+        .end_page = 0
+    };
+    calculate_render_area_buffer_length(&splash_area);
+    
+    // Buffer do display fora da pilha de main (1 KB em .bss, contado no relatório de memória)
+    static uint8_t ssd[ssd1306_buffer_length];
     
-    // Configuração do PWM para o buzzer
-    gpio_set_function(BUZZER, GPIO_FUNC_PWM);
-    uint slice1 = pwm_gpio_to_slice_num(BUZZER);
-    pwm_set_wrap(slice1, PWM_WRAP);
-    pwm_set_clkdiv(slice1, 30.0f);
-    pwm_set_chan_level(slice1, PWM_CHAN_A, 0);
-    pwm_set_enabled(slice1, true);
+    // Configuração do PWM para o buzzer (o slice só é habilitado durante os alertas)
+    buzzer_init(BUZZER);
     
     // Configuração dos botões
     gpio_init(BUTTONA_PIN);
@@ -509,60 +749,200 @@ int main() {
     // Inicialização do sistema de média móvel para BPM
     inicializar_sistema_bpm();
     
-    // Mensagem inicial
-    process_command("Inicializando...", "Sistema de", "Monitoramento", "de Saude", ssd, &frame_area);
-    sleep_ms(2000);
+    // Gerenciador de energia (escurecimento do display e sono entre amostras)
+    energia_init();
     
-    // Exibe o menu principal
-    draw_menu(ssd, &frame_area);
+#if TELEMETRIA_ENABLED
+    // Conexão ao Wi-Fi assíncrona: o boot não espera o enlace
+    telemetria_init(&telemetria);
+#endif
+    
+    // No reinício a quente recupera a tela, o alerta em exibição e o tempo decorrido desde
+    // a última gravação dos lembretes, até o reset e do reset até aqui (o timer recomeça
+    // no reset); no boot a frio só a flash é lida
+    uint32_t desde_reset_ms = (uint32_t)agora_ms();
+    if (reinicio_quente) {
+        carregar_lembretes(reinicio.ms_desde_salvamento + desde_reset_ms, REINICIO_WATCHDOG_MS + desde_reset_ms);
+    } else {
+        carregar_lembretes(0, 0);
+    }
+    
+    bool splash_ativo = !reinicio_quente;
+    uint8_t pagina_splash = 0;
+    uint32_t fim_splash_ms = to_ms_since_boot(get_absolute_time()) + TEMPO_SPLASH_MS;
+    
+    if (reinicio_quente) {
+        menu_index = reinicio.menu_indice % MENU_ITEMS;
+        submenu_active = reinicio.submenu_ativo;
+        submenu_index = reinicio.submenu_indice % MENU_ITEMS;
+        pagina_vfc = reinicio.pagina_vfc;
+        lembrete_pendente = lembrete_pendente || reinicio.lembrete_pendente;
+        if (reinicio.alerta != SEM_ALERTA) {
+            alerta_ativo = true;
+            alerta_atual = (enum TipoAlerta)reinicio.alerta;
+            gpio_put(RED_PIN, 1);
+            buzzer_ligar();
+        }
+        // Redesenha a tela restaurada por inteiro
+        button_pressed = true;
+    } else {
+        // O boot a frio (ligar, brownout) entra direto no monitoramento: os sensores e os
+        // alertas, inclusive a queda, são avaliados desde a primeira volta do laço, sem
+        // esperar alguém navegar até "Monitorar"
+        menu_index = 0;
+        submenu_active = true;
+        submenu_index = 0;
+        
+        // Mensagem inicial: desenhada no buffer e enviada uma página por volta do laço,
+        // sem atrasar a amostragem nem a avaliação de alertas
+        memset(ssd, 0, ssd1306_buffer_length);
+        ssd1306_draw_string(ssd, 5, 0, "Inicializando...");
+        ssd1306_draw_string(ssd, 5, 8, "Sistema de");
+        ssd1306_draw_string(ssd, 5, 16, "Monitoramento");
+        ssd1306_draw_string(ssd, 5, 24, "de Saude");
+    }
     
     bool update_display = false;
     uint32_t last_adc_update = 0;
+#if TELEMETRIA_ENABLED
+    enum TipoAlerta alerta_telemetria = SEM_ALERTA; // Último alerta registrado na telemetria
+#endif
     
     while(1) {
         uint32_t current_time = to_ms_since_boot(get_absolute_time());
         
-        // Verifica se o alarme ativo atingiu o tempo definido
-        if (alarm_active && current_time >= alarm_trigger_time_ms) {
+        watchdog_update();
+        salvar_estado_reinicio();
+        
+#if TRACE_ENABLED
+        if (getchar_timeout_us(0) == 'T') {
+            printf("BOOT %llu us ate a primeira avaliacao de alertas\n", (unsigned long long)tempo_primeira_avaliacao_us);
+            energia_imprimir_estatisticas();
+            trace_dump();
+        }
+#endif
+        
+#if TELEMETRIA_ENABLED
+        // Registra o início e o fim de cada alerta e envia no máximo um lote por volta,
+        // antes do desvio do alerta para que a telemetria siga durante a tela de alerta
+        enum TipoAlerta alerta_exibido = alerta_ativo ? alerta_atual : SEM_ALERTA;
+        if (alerta_exibido != alerta_telemetria) {
+            telemetria_registrar_alerta(&telemetria, current_time, alerta_exibido, media_bpm);
+            alerta_telemetria = alerta_exibido;
+        }
+        telemetria_processar(&telemetria, current_time);
+#endif
+        
+        // Avança a roda de lembretes; os recorrentes já voltam reagendados e não mudam o
+        // que está na flash, só um de disparo único vencido precisa sair dela
+        uint16_t vencidos[TEMPORIZADORES_MAX];
+        int quantidade_vencidos = temporizadores_avancar(&lembretes, agora_ms(), vencidos, TEMPORIZADORES_MAX);
+        if (quantidade_vencidos > 0) {
+            lembrete_pendente = true;
+            for (int i = 0; i < quantidade_vencidos; i++) {
+                if (temporizadores_obter(&lembretes, vencidos[i]) == NULL) {
+                    salvar_lembretes();
+                    break;
+                }
+            }
+        }
+        
+        // Regravação diária (fora dos alertas, para não atrasar o buzzer)
+        if (lembretes.quantidade > 0 && !alerta_ativo && agora_ms() - ultimo_salvamento_ms >= LEMBRETES_REGRAVAR_MS) {
+            salvar_lembretes();
+        }
+        
+        // Dispara o alerta de medicação assim que não houver outro alerta na tela
+        if (lembrete_pendente && !alerta_ativo) {
+            lembrete_pendente = false;
             alerta_ativo = true;
             alerta_atual = ALARME_TEMPORIZADOR;
-            alarm_active = false;
             // Ativa LED e buzzer
             gpio_put(RED_PIN, 1);
-            pwm_set_gpio_level(BUZZER, PWM_WRAP / 2);
+            buzzer_ligar();
         }
         
         if (alerta_ativo) {
+            // Display aceso e com brilho máximo enquanto houver alerta
+            energia_registrar_atividade();
+            energia_atualizar_display();
+            splash_ativo = false;
             draw_alerta(ssd, &frame_area);
-            sleep_ms(50);
+            energia_dormir_ms(50);
             continue;
         }
         
-        // Se estivermos no submenu de "Alarmes" e o alarme não estiver ativo, processa os ajustes com o joystick
-        if (submenu_active && submenu_index == 1 && !alarm_active) {
+        // Envia a mensagem inicial uma página por volta; o menu aparece ao fim do tempo
+        // ou quando um botão é pressionado
+        if (splash_ativo) {
+            if (pagina_splash < ssd1306_n_pages) {
+                splash_area.start_page = splash_area.end_page = pagina_splash;
+                render_on_display(ssd + pagina_splash * ssd1306_width, &splash_area);
+                pagina_splash++;
+            } else if (current_time >= fim_splash_ms || button_pressed) {
+                splash_ativo = false;
+                button_pressed = true;
+            }
+        }
+        
+        // Ajustes do alarme e navegação na lista de lembretes com o joystick
+        if (submenu_active && submenu_index == 1) {
             process_alarm_input();
+        } else if (submenu_active && submenu_index == 2) {
+            process_lembretes_input();
         }
         
         update_display = process_joystick_navigation();
         
-        // Se o usuário confirmou a configuração do alarme, ativa-o
-        if (confirm_alarm && submenu_active && submenu_index == 1 && !alarm_active) {
-            alarm_active = true;
-            alarm_trigger_time_ms = current_time + alarm_set_seconds * 1000;
+        // Se o usuário confirmou a configuração do alarme, cria um lembrete recorrente
+        if (confirm_alarm && submenu_active && submenu_index == 1) {
+            uint32_t periodo_ms = alarm_set_seconds * 1000;
+            // Com as TEMPORIZADORES_MAX posições ocupadas nada é criado nem gravado
+            if (temporizadores_adicionar(&lembretes, agora_ms() + periodo_ms, periodo_ms) >= 0) {
+                lembretes_cheia = false;
+                salvar_lembretes();
+            } else {
+                lembretes_cheia = true;
+            }
             confirm_alarm = false;
         }
         
+        // Cancela o lembrete selecionado na lista
+        if (cancelar_lembrete && submenu_active && submenu_index == 2) {
+            uint16_t ids[TEMPORIZADORES_MAX];
+            int quantidade = temporizadores_listar(&lembretes, ids, TEMPORIZADORES_MAX);
+            if (lembrete_selecionado < quantidade) {
+                temporizadores_cancelar(&lembretes, ids[lembrete_selecionado]);
+                salvar_lembretes();
+            }
+            cancelar_lembrete = false;
+        }
+        
         if ((submenu_active || button_pressed) && (current_time - last_adc_update > 250)) {
             update_display = true;
             last_adc_update = current_time;
         }
         
-        if (update_display || button_pressed) {
+        // Com o display apagado nada é desenhado; a tela é refeita ao reacender
+        bool display_apagado = energia_display_apagado();
+        bool monitorando = submenu_active && submenu_index == 0;
+        
+        if (!splash_ativo && !display_apagado && (update_display || button_pressed)) {
             if (submenu_active) {
                 if (submenu_index == 0) {
-                    draw_submenu_adc(ssd, &frame_area);
+                    if (pagina_vfc) {
+                        draw_submenu_vfc(ssd, &text_area);
+                    } else {
+                        draw_submenu_adc(ssd, &text_area);
+                    }
+                    // Ao entrar na tela (ou voltar de um alerta) o gráfico é redesenhado por inteiro
+                    if (button_pressed) {
+                        grafico_bpm_redesenhar(&grafico_bpm, ssd);
+                    }
                 } else if (submenu_index == 1) {
                     draw_submenu_alarmes(ssd, &frame_area);
+                } else if (submenu_index == 2) {
+                    draw_submenu_lembretes(ssd, &frame_area);
                 }
             } else {
                 draw_menu(ssd, &frame_area);
@@ -571,7 +951,35 @@ int main() {
             update_display = false;
         }
         
-        sleep_ms(30);
+        // Envia somente as colunas novas do gráfico de tendência
+        if (!splash_ativo && !display_apagado && monitorando) {
+            grafico_bpm_atualizar(&grafico_bpm, ssd);
+        }
+        
+        energia_atualizar_display();
+        if (display_apagado && !energia_display_apagado()) {
+            button_pressed = true;
+        }
+        
+        // Sem monitoramento, lembretes em contagem ou alerta, e com o display apagado, nada
+        // depende do tempo: entra no modo dormente até um botão ser pressionado (o watchdog
+        // para junto com o clk_ref e volta a contar ao acordar)
+        bool telemetria_ocupada = false;
+#if TELEMETRIA_ENABLED
+        // O modo dormente desliga as PLLs que alimentam o CYW43: só com a fila vazia
+        telemetria_ocupada = telemetria_pendente(&telemetria);
+#endif
+        if (energia_display_apagado() && lembretes.quantidade == 0 && !alerta_ativo && !monitorando && !telemetria_ocupada) {
+            energia_dormente_ate_botao(botoes_despertar, count_of(botoes_despertar));
+            button_pressed = true;
+        } else if (energia_display_apagado() && monitorando) {
+            // Monitorando com o display apagado só a próxima amostra importa (ou um botão):
+            // dorme o intervalo adaptativo inteiro em vez de acordar a cada 30 ms
+            uint32_t desde_amostra = to_ms_since_boot(get_absolute_time()) - ultimo_tempo_amostragem;
+            energia_dormir_ms(desde_amostra < intervalo_amostragem_ms ? intervalo_amostragem_ms - desde_amostra : 1);
+        } else {
+            energia_dormir_ms(30);
+        }
     }
     
     return 0;